@@ -6,10 +6,12 @@
 
 #include "vsnlogger/macros.h"
 
+VSN_DECLARE_COMPONENT(LibB);
+
 namespace libB {
 
 bool generate_report(const std::string& frequency) {
-    VSN_COMPONENT_INFO("LibB", "Generating {} report", frequency);
+    VSN_COMPONENT_INFO(LibB, "Generating {} report", frequency);
 
     // Simulate report generation (takes time)
     std::this_thread::sleep_for(std::chrono::milliseconds(300));
@@ -17,29 +19,29 @@ bool generate_report(const std::string& frequency) {
     // Validate frequency parameter
     if (frequency != "daily" && frequency != "weekly" &&
         frequency != "monthly" && frequency != "quarterly") {
-        VSN_COMPONENT_WARN("LibB", "Unusual report frequency requested: {}",
+        VSN_COMPONENT_WARN(LibB, "Unusual report frequency requested: {}",
                            frequency);
     }
 
     // Simulate successful report generation
-    VSN_COMPONENT_INFO("LibB", "Report generation complete");
+    VSN_COMPONENT_INFO(LibB, "Report generation complete");
     return true;
 }
 
 bool process_config(const std::string& config_file) {
-    VSN_COMPONENT_INFO("LibB", "Processing configuration file: {}",
+    VSN_COMPONENT_INFO(LibB, "Processing configuration file: {}",
                        config_file);
 
     // Check if file exists
     std::ifstream file(config_file);
     if (!file.good()) {
-        VSN_COMPONENT_ERROR("LibB", "Configuration file not found: {}",
+        VSN_COMPONENT_ERROR(LibB, "Configuration file not found: {}",
                             config_file);
         return false;
     }
 
     // Simulate configuration processing
-    VSN_COMPONENT_DEBUG("LibB", "Parsing configuration parameters");
+    VSN_COMPONENT_DEBUG(LibB, "Parsing configuration parameters");
 
     // Count lines as a simple metric
     int line_count = 0;
@@ -48,7 +50,7 @@ bool process_config(const std::string& config_file) {
         line_count++;
     }
 
-    VSN_COMPONENT_INFO("LibB", "Processed {} configuration parameters",
+    VSN_COMPONENT_INFO(LibB, "Processed {} configuration parameters",
                        line_count);
     return true;
 }
@@ -0,0 +1,125 @@
+/**
+ * @file bench.h
+ * @brief Minimal microbenchmark harness for VSNLogger
+ *
+ * @details
+ * Benchmarks register themselves with VSN_BENCH and are run by name by
+ * vsnlogger_bench. Each measurement is repeated and the fastest run is
+ * reported, in nanoseconds per operation, which filters out scheduling
+ * noise on shared machines.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "error_codes.h"
+#include "vsnlogger/async.h"
+
+namespace vsn {
+namespace logger {
+namespace bench {
+
+/** Repetitions of each measurement, the fastest one is reported */
+static constexpr std::uint32_t k_repetitions = 5U;
+
+/**
+ * @brief Benchmark body
+ */
+using BenchFn_t = void (*)(void);
+
+/**
+ * @brief Add a benchmark to the run list
+ *
+ * @param[in] name Benchmark name, selected by the command line filter
+ * @param[in] run Benchmark body
+ * @return true, for use in a static initializer
+ */
+bool RegisterBench(const char* name, BenchFn_t run);
+
+/**
+ * @brief Print one measurement
+ *
+ * @param[in] label Description of the measured operation
+ * @param[in] nanos Nanoseconds per operation
+ */
+void Report(const std::string& label, double nanos);
+
+/**
+ * @brief Print the ratio of two measurements
+ *
+ * @param[in] label Description of the comparison
+ * @param[in] baseline Nanoseconds per operation of the reference
+ * @param[in] measured Nanoseconds per operation being compared
+ */
+void ReportRatio(const std::string& label, double baseline, double measured);
+
+/**
+ * @brief Initialize the default logger writing to the console only
+ *
+ * @details
+ * The runner sends standard output to /dev/null, so records take the
+ * full formatting and sink path without terminal or disk I/O.
+ *
+ * @param[in] appName Application name
+ * @param[in] level Active level
+ * @param[in] options Asynchronous mode settings
+ * @return Operation result code
+ */
+E_Result InitializeQuiet(const std::string& appName, E_LogLevel level,
+                         const async::AsyncOptions_t& options);
+
+/**
+ * @brief Keep a value from being optimized away
+ */
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Time a loop, best of k_repetitions runs
+ *
+ * @param[in] iterations Calls of body per run
+ * @param[in] body Operation, called with the iteration number
+ * @return Nanoseconds per call
+ */
+template <typename Body>
+double MeasureNs(std::uint64_t iterations, Body&& body) {
+    double best = 0.0;
+    for (std::uint32_t run = 0U; run < k_repetitions; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t i = 0U; i < iterations; ++i) {
+            body(i);
+        }
+        const auto stop = std::chrono::steady_clock::now();
+
+        const double nanos =
+            std::chrono::duration<double, std::nano>(stop - start).count() /
+            static_cast<double>(iterations);
+        if ((0U == run) || (nanos < best)) {
+            best = nanos;
+        }
+    }
+    return best;
+}
+
+} /* namespace bench */
+} /* namespace logger */
+} /* namespace vsn */
+
+/**
+ * @brief Define and register a benchmark
+ *
+ * @param name Function name of the benchmark, also its registered name
+ */
+#define VSN_BENCH(name)                                                   \
+    static void name(void);                                               \
+    [[maybe_unused]] static const bool name##Registered =                 \
+        ::vsn::logger::bench::RegisterBench(#name, &name);                \
+    static void name(void)
@@ -0,0 +1,115 @@
+/**
+ * @file bench_main.cpp
+ * @brief Runner of the VSNLogger microbenchmarks
+ *
+ * @details
+ * Usage: vsnlogger_bench [filter]
+ *
+ * Runs every registered benchmark whose name contains the filter, all of
+ * them without one, in name order. Results go to standard output; the
+ * records logged while measuring go to /dev/null instead.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <unistd.h>
+
+#include "bench.h"
+#include "vsnlogger/config.h"
+#include "vsnlogger/logger.h"
+
+namespace vsn {
+namespace logger {
+namespace bench {
+
+/**
+ * @brief Registered benchmark
+ */
+struct BenchCase_t {
+    const char* m_name; /**< Benchmark name */
+    BenchFn_t m_run;    /**< Benchmark body */
+};
+
+/* Destination of the results, the original standard output */
+static std::FILE* g_report = stdout;
+
+/* Registered benchmarks, filled by static initializers */
+static std::vector<BenchCase_t>& Registry(void) {
+    static std::vector<BenchCase_t> cases;
+    return cases;
+}
+
+bool RegisterBench(const char* name, BenchFn_t run) {
+    Registry().push_back(BenchCase_t{name, run});
+    return true;
+}
+
+void Report(const std::string& label, double nanos) {
+    std::fprintf(g_report, "  %-52s %10.2f ns/op\n", label.c_str(), nanos);
+}
+
+void ReportRatio(const std::string& label, double baseline, double measured) {
+    std::fprintf(g_report, "  %-52s %10.2fx\n", label.c_str(),
+                 (measured > 0.0) ? (baseline / measured) : 0.0);
+}
+
+E_Result InitializeQuiet(const std::string& appName, E_LogLevel level,
+                         const async::AsyncOptions_t& options) {
+    auto& config = LogConfig::GetInstance();
+    static_cast<void>(config.Set(appName, "console_output", "true"));
+    static_cast<void>(config.Set(appName, "use_colors", "false"));
+    static_cast<void>(config.Set(appName, "file_output", "false"));
+    return Logger::Initialize(appName, "/tmp", level, options);
+}
+
+} /* namespace bench */
+} /* namespace logger */
+} /* namespace vsn */
+
+int main(int argc, char** argv) {
+    using vsn::logger::bench::BenchCase_t;
+    using vsn::logger::bench::g_report;
+
+    /* Keep standard output for the results, discard logged records */
+    g_report = fdopen(dup(STDOUT_FILENO), "w");
+    if ((nullptr == g_report) ||
+        (nullptr == std::freopen("/dev/null", "w", stdout))) {
+        std::fprintf(stderr, "Cannot redirect standard output\n");
+        return EXIT_FAILURE;
+    }
+
+#ifndef __OPTIMIZE__
+    std::fprintf(stderr, "Warning: built without optimization\n");
+#endif
+
+    const char* const filter = (argc > 1) ? argv[1] : "";
+    std::vector<BenchCase_t> cases = vsn::logger::bench::Registry();
+    std::sort(cases.begin(), cases.end(),
+              [](const BenchCase_t& left, const BenchCase_t& right) {
+                  return std::strcmp(left.m_name, right.m_name) < 0;
+              });
+
+    bool found = false;
+    for (const auto& entry : cases) {
+        if (nullptr == std::strstr(entry.m_name, filter)) {
+            continue;
+        }
+        found = true;
+        std::fprintf(g_report, "%s\n", entry.m_name);
+        entry.m_run();
+        std::fflush(g_report);
+    }
+
+    if (!found) {
+        std::fprintf(stderr, "No benchmark matches '%s'\n", filter);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
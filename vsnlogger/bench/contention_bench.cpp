@@ -0,0 +1,132 @@
+/**
+ * @file contention_bench.cpp
+ * @brief Scaling of default logger access with the number of threads
+ *
+ * @details
+ * Every thread runs the same loop; the time per operation of one thread
+ * staying flat as threads are added means throughput scales linearly. The
+ * mutex-guarded access returning a reference to the shared pointer is the
+ * path GetDefaultLogger() replaced, kept as the reference.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "vsnlogger/macros.h"
+
+using namespace vsn::logger;
+
+namespace {
+
+/** Operations per thread and run */
+constexpr std::uint64_t k_iterations = 1000000U;
+
+/** Instance published the way GetDefaultLogger() used to */
+std::mutex g_referenceMutex;
+std::shared_ptr<Logger> g_referenceInstance;
+
+/**
+ * @brief Default logger access as it was, a lock per call and no copy
+ *
+ * @details
+ * Kept out of line like GetDefaultLogger(), which lives in the library.
+ */
+__attribute__((noinline)) const std::shared_ptr<Logger>&
+GetReferenceLogger(void) {
+    std::lock_guard<std::mutex> lock(g_referenceMutex);
+    return g_referenceInstance;
+}
+
+/**
+ * @brief Run body on several threads at once
+ *
+ * @return Wall nanoseconds per operation of one thread, best of runs
+ */
+template <typename Body>
+double MeasureThreadsNs(std::uint32_t threadCount, std::uint64_t iterations,
+                        const Body& body) {
+    double best = 0.0;
+    for (std::uint32_t run = 0U; run < bench::k_repetitions; ++run) {
+        std::atomic<std::uint32_t> ready(0U);
+        std::atomic<bool> go(false);
+        std::vector<std::thread> threads;
+        for (std::uint32_t t = 0U; t < threadCount; ++t) {
+            threads.emplace_back([&]() {
+                ready.fetch_add(1U);
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (std::uint64_t i = 0U; i < iterations; ++i) {
+                    body(i);
+                }
+            });
+        }
+        while (ready.load() != threadCount) {
+            std::this_thread::yield();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const auto stop = std::chrono::steady_clock::now();
+
+        const double nanos =
+            std::chrono::duration<double, std::nano>(stop - start).count() /
+            static_cast<double>(iterations);
+        if ((0U == run) || (nanos < best)) {
+            best = nanos;
+        }
+    }
+    return best;
+}
+
+} /* namespace */
+
+VSN_BENCH(contention_default_logger) {
+    if (E_Result::E_SUCCESS !=
+        bench::InitializeQuiet("bench_contention", E_LogLevel::E_INFO,
+                               async::GetDefaultOptions())) {
+        return;
+    }
+    g_referenceInstance = Logger::GetDefaultLogger();
+
+    /* Beyond the core count threads only share the processors */
+    const std::uint32_t maxThreads =
+        std::max(4U, std::thread::hardware_concurrency());
+    for (std::uint32_t threads = 1U; threads <= maxThreads; threads *= 2U) {
+        const std::string suffix = " x" + std::to_string(threads) + " threads";
+
+        bench::Report(
+            "mutex + shared_ptr reference (reference)" + suffix,
+            MeasureThreadsNs(threads, k_iterations, [](std::uint64_t) {
+                const auto& logger = GetReferenceLogger();
+                bench::DoNotOptimize(logger->ShouldLog(E_LogLevel::E_DEBUG));
+            }));
+
+        bench::Report(
+            "GetDefaultLogger() + ShouldLog()" + suffix,
+            MeasureThreadsNs(threads, k_iterations, [](std::uint64_t) {
+                auto& logger = Logger::GetDefaultLogger();
+                bench::DoNotOptimize(logger->ShouldLog(E_LogLevel::E_DEBUG));
+            }));
+
+        bench::Report(
+            "VSN_INFO to /dev/null" + suffix,
+            MeasureThreadsNs(threads, k_iterations / 20U, [](std::uint64_t i) {
+                VSN_INFO("contention {} {}", i, 2.5);
+            }));
+    }
+
+    g_referenceInstance.reset();
+    static_cast<void>(Logger::Shutdown());
+}
@@ -0,0 +1,87 @@
+/**
+ * @file disabled_bench.cpp
+ * @brief Cost of statements below the active level
+ *
+ * @details
+ * The logger runs at INFO, so every DEBUG statement measured here is
+ * discarded. An empty loop is the floor; the eagerly evaluated argument
+ * shows what a diagnostic helper costs when the call site does not defer
+ * it. Closures must never run, which is checked after the measurements.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "bench.h"
+#include "vsnlogger/macros.h"
+
+using namespace vsn::logger;
+
+namespace {
+
+/** Calls per run */
+constexpr std::uint64_t k_iterations = 10000000U;
+
+/** Calls per run of the eager helper */
+constexpr std::uint64_t k_eagerIterations = 100000U;
+
+/** Invocations of the diagnostic helper */
+std::uint64_t g_helperCalls = 0U;
+
+/**
+ * @brief Diagnostic helper with a realistic cost, a small state dump
+ */
+std::string DumpState(std::uint64_t seed) {
+    ++g_helperCalls;
+    std::string out = "state:";
+    for (std::uint64_t i = 0U; i < 16U; ++i) {
+        out += ' ';
+        out += std::to_string(seed * i);
+    }
+    return out;
+}
+
+} /* namespace */
+
+VSN_BENCH(disabled_statements) {
+    if (E_Result::E_SUCCESS !=
+        bench::InitializeQuiet("bench_disabled", E_LogLevel::E_INFO,
+                               async::GetDefaultOptions())) {
+        return;
+    }
+    auto& logger = Logger::GetDefaultLogger();
+
+    bench::Report("empty loop (reference)",
+                  bench::MeasureNs(k_iterations, [](std::uint64_t i) {
+                      bench::DoNotOptimize(i);
+                  }));
+    bench::Report("VSN_DEBUG, int",
+                  bench::MeasureNs(k_iterations, [](std::uint64_t i) {
+                      VSN_DEBUG("request {}", i);
+                  }));
+    bench::Report("VSN_DEBUG_LAZY, closure",
+                  bench::MeasureNs(k_iterations, [](std::uint64_t i) {
+                      VSN_DEBUG_LAZY("{}", [i] { return DumpState(i); });
+                  }));
+    bench::Report("Logger::Debug, closure",
+                  bench::MeasureNs(k_iterations, [&](std::uint64_t i) {
+                      logger->Debug(VSN_SRC_LOC, "{}",
+                                    [i] { return DumpState(i); });
+                  }));
+    const std::uint64_t lazyCalls = g_helperCalls;
+
+    bench::Report("Logger::Debug, eager argument",
+                  bench::MeasureNs(k_eagerIterations, [&](std::uint64_t i) {
+                      logger->Debug(VSN_SRC_LOC, "{}", DumpState(i));
+                  }));
+
+    if (0U != lazyCalls) {
+        std::fprintf(stderr, "Error: disabled closures ran %llu times\n",
+                     static_cast<unsigned long long>(lazyCalls));
+    }
+
+    static_cast<void>(Logger::Shutdown());
+}
@@ -0,0 +1,138 @@
+/**
+ * @file enqueue_bench.cpp
+ * @brief Cost of a log call on the calling thread in each logging mode
+ *
+ * @details
+ * Records are logged in batches smaller than the queue and the queue is
+ * drained between batches outside the timed region, so producers never
+ * wait for room and only the enqueue itself is measured. The writer
+ * thread still runs while a batch is logged; with a single processor its
+ * rendering time is included in the wall-clock result. The CPU time of
+ * the calling thread leaves it out, which is what a producer costs when
+ * the writer has a core of its own.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include <time.h>
+
+#include <string>
+
+#include "bench.h"
+#include "vsnlogger/macros.h"
+
+using namespace vsn::logger;
+
+namespace {
+
+/** Records logged between two drains */
+constexpr std::uint32_t k_batchSize = 4096U;
+
+/** Batches per run */
+constexpr std::uint32_t k_batches = 32U;
+
+/** Queue and ring capacity, larger than a batch */
+constexpr std::uint32_t k_queueSize = 16384U;
+
+/**
+ * @brief Per-record cost of a batch, by two clocks
+ */
+struct BatchCost_t {
+    double m_wallNs;   /**< Elapsed time, the writer included on one core */
+    double m_threadNs; /**< CPU time of the calling thread only */
+};
+
+/**
+ * @brief Read the CPU time of the calling thread
+ */
+double ThreadCpuNs(void) {
+    struct timespec now = {0, 0};
+    static_cast<void>(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now));
+    return (static_cast<double>(now.tv_sec) * 1e9) +
+           static_cast<double>(now.tv_nsec);
+}
+
+/**
+ * @brief Time batches of records, excluding the drains between them
+ *
+ * @return Nanoseconds per record, best of runs for each clock
+ */
+template <typename Body>
+BatchCost_t MeasureBatches(const Body& body) {
+    auto& logger = Logger::GetDefaultLogger();
+    BatchCost_t best{0.0, 0.0};
+    for (std::uint32_t run = 0U; run < bench::k_repetitions; ++run) {
+        double wall = 0.0;
+        double thread = 0.0;
+        for (std::uint32_t batch = 0U; batch < k_batches; ++batch) {
+            const double threadStart = ThreadCpuNs();
+            const auto start = std::chrono::steady_clock::now();
+            for (std::uint32_t i = 0U; i < k_batchSize; ++i) {
+                body(i);
+            }
+            const auto stop = std::chrono::steady_clock::now();
+            thread += ThreadCpuNs() - threadStart;
+            wall +=
+                std::chrono::duration<double, std::nano>(stop - start).count();
+            static_cast<void>(logger->Flush());
+        }
+
+        const double records = static_cast<double>(k_batches * k_batchSize);
+        if ((0U == run) || ((wall / records) < best.m_wallNs)) {
+            best.m_wallNs = wall / records;
+        }
+        if ((0U == run) || ((thread / records) < best.m_threadNs)) {
+            best.m_threadNs = thread / records;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Print both clocks of one measurement
+ */
+void ReportCost(const std::string& label, const BatchCost_t& cost) {
+    bench::Report(label, cost.m_wallNs);
+    bench::Report(label + ", thread CPU", cost.m_threadNs);
+}
+
+/**
+ * @brief Measure typical argument mixes in one logging mode
+ */
+void RunMode(const std::string& mode, const async::AsyncOptions_t& options) {
+    if (E_Result::E_SUCCESS !=
+        bench::InitializeQuiet("bench_enqueue", E_LogLevel::E_INFO, options)) {
+        return;
+    }
+    static_cast<void>(Logger::GetDefaultLogger()->PrepareThread());
+
+    const std::string user = "jdoe";
+    ReportCost(mode + ": int, double", MeasureBatches([](std::uint32_t i) {
+                   VSN_INFO("request {} took {} ms", i, 2.5);
+               }));
+    ReportCost(mode + ": int, char*, string",
+               MeasureBatches([&user](std::uint32_t i) {
+                   VSN_INFO("request {} from {} as {}", i, "10.0.0.1", user);
+               }));
+
+    static_cast<void>(Logger::Shutdown());
+}
+
+} /* namespace */
+
+VSN_BENCH(enqueue_modes) {
+    async::AsyncOptions_t options = async::GetDefaultOptions();
+    RunMode("sync", options);
+
+    options.m_enabled = true;
+    options.m_queueSize = k_queueSize;
+    options.m_ringSize = k_queueSize;
+    RunMode("async", options);
+
+    options.m_deferredFormatting = true;
+    RunMode("deferred", options);
+
+    options.m_perThreadQueues = true;
+    RunMode("deferred per-thread", options);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file fanout_bench.cpp
+ * @brief Three outputs behind a fan-out sink against separate sinks
+ *
+ * @details
+ * Three file sinks writing to /dev/null share the colored pattern. Side
+ * by side each formats every record; behind CreateFanoutSink() a record
+ * is formatted once and the text written three times. One sink alone is
+ * the cost of formatting and writing once.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <spdlog/logger.h>
+
+#include "bench.h"
+#include "vsnlogger/formatters.h"
+#include "vsnlogger/sinks.h"
+
+using namespace vsn::logger;
+
+namespace {
+
+/** Records per run */
+constexpr std::uint64_t k_iterations = 200000U;
+
+/** Outputs sharing one pattern */
+constexpr std::size_t k_outputs = 3U;
+
+/**
+ * @brief Create file sinks discarding their output
+ */
+std::vector<spdlog::sink_ptr> CreateOutputs(std::size_t count) {
+    std::vector<spdlog::sink_ptr> outputs;
+    for (std::size_t i = 0U; i < count; ++i) {
+        spdlog::sink_ptr sink =
+            sinks::CreateFileSink("/dev/null", false, 0U, 0U);
+        if (!sink) {
+            return {};
+        }
+        outputs.push_back(sink);
+    }
+    return outputs;
+}
+
+/**
+ * @brief Time records logged through the given sinks
+ */
+double MeasureLoggerNs(std::vector<spdlog::sink_ptr> outputs,
+                       const std::string& pattern) {
+    spdlog::logger logger("bench_fanout", outputs.begin(), outputs.end());
+    logger.set_pattern(pattern);
+    return bench::MeasureNs(k_iterations, [&](std::uint64_t i) {
+        logger.log(spdlog::level::info, "request {} took {} ms", i, 2.5);
+    });
+}
+
+} /* namespace */
+
+VSN_BENCH(fanout_sinks) {
+    std::string pattern;
+    static_cast<void>(formatters::GetPattern("colored", pattern));
+
+    const std::vector<spdlog::sink_ptr> single = CreateOutputs(1U);
+    const std::vector<spdlog::sink_ptr> separate = CreateOutputs(k_outputs);
+    const std::vector<spdlog::sink_ptr> fanned = CreateOutputs(k_outputs);
+    const spdlog::sink_ptr fanout = sinks::CreateFanoutSink(fanned);
+    if (single.empty() || separate.empty() || !fanout) {
+        return;
+    }
+
+    const double one = MeasureLoggerNs(single, pattern);
+    const double side = MeasureLoggerNs(separate, pattern);
+    const double once = MeasureLoggerNs({fanout}, pattern);
+
+    bench::Report("1 file sink (reference)", one);
+    bench::Report("3 file sinks side by side", side);
+    bench::Report("3 file sinks behind a fan-out sink", once);
+    bench::ReportRatio("speedup of the fan-out", side, once);
+}
@@ -0,0 +1,84 @@
+/**
+ * @file format_bench.cpp
+ * @brief Run-time parsed against compiled format strings
+ *
+ * @details
+ * Formatting alone is measured through FormatBounded(), the step shared by
+ * both paths, across typical argument mixes. The full calls compare
+ * Logger::Info(), which parses its format at run time, with VSN_INFO,
+ * whose site compiles it.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include <string>
+
+#include "bench.h"
+#include "vsnlogger/macros.h"
+
+using namespace vsn::logger;
+
+namespace {
+
+/** Calls per run */
+constexpr std::uint64_t k_iterations = 1000000U;
+
+/** Message limit, the one the logger applies */
+constexpr std::size_t k_limit = 256U;
+
+/**
+ * @brief Report both paths for one format and argument mix
+ */
+#define VSN_BENCH_FORMAT(label, text, ...)                                    \
+    do {                                                                      \
+        const double runtime =                                                \
+            bench::MeasureNs(k_iterations, [&](std::uint64_t i) {             \
+                bench::DoNotOptimize(detail::FormatBounded(                   \
+                    k_limit, nullptr, 0U, detail::RuntimeFormat_t(), text,    \
+                    __VA_ARGS__));                                            \
+            });                                                               \
+        const double compiled =                                               \
+            bench::MeasureNs(k_iterations, [&](std::uint64_t i) {             \
+                bench::DoNotOptimize(detail::FormatBounded(                   \
+                    k_limit, nullptr, 0U, FMT_COMPILE(text), text,            \
+                    __VA_ARGS__));                                            \
+            });                                                               \
+        bench::Report(std::string("runtime:  ") + (label), runtime);          \
+        bench::Report(std::string("compiled: ") + (label), compiled);         \
+        bench::ReportRatio(std::string("speedup:  ") + (label), runtime,      \
+                           compiled);                                         \
+    } while (false)
+
+} /* namespace */
+
+VSN_BENCH(format_runtime_vs_compiled) {
+    const std::string user = "jdoe";
+    const char* const host = "10.0.0.1";
+
+    VSN_BENCH_FORMAT("int", "request {}", i);
+    VSN_BENCH_FORMAT("int, double", "request {} took {} ms", i, 2.5);
+    VSN_BENCH_FORMAT("int, char*, string", "request {} from {} as {}", i,
+                     host, user);
+    VSN_BENCH_FORMAT("5 mixed, width and precision",
+                     "[{:>8}] {} {:.3f} {:#x} {}", user, i, 3.14159, i, host);
+
+    if (E_Result::E_SUCCESS !=
+        bench::InitializeQuiet("bench_format", E_LogLevel::E_INFO,
+                               async::GetDefaultOptions())) {
+        return;
+    }
+    auto& logger = Logger::GetDefaultLogger();
+
+    bench::Report("Logger::Info (runtime), to /dev/null",
+                  bench::MeasureNs(k_iterations / 10U, [&](std::uint64_t i) {
+                      logger->Info(VSN_SRC_LOC, "request {} from {} as {}", i,
+                                   host, user);
+                  }));
+    bench::Report("VSN_INFO (compiled), to /dev/null",
+                  bench::MeasureNs(k_iterations / 10U, [&](std::uint64_t i) {
+                      VSN_INFO("request {} from {} as {}", i, host, user);
+                  }));
+
+    static_cast<void>(Logger::Shutdown());
+}
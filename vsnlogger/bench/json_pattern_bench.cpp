@@ -0,0 +1,92 @@
+/**
+ * @file json_pattern_bench.cpp
+ * @brief JsonFormatter against the text patterns
+ *
+ * @details
+ * Formats records the way a sink does, into a reused buffer, with the
+ * record time advancing a microsecond per call. The default pattern
+ * carries the same fields as a JSON record; the json pattern string is
+ * what JsonFormatter replaced.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <spdlog/pattern_formatter.h>
+
+#include "bench.h"
+#include "vsnlogger/formatters.h"
+
+using namespace vsn::logger;
+
+namespace {
+
+/** Calls per run */
+constexpr std::uint64_t k_iterations = 500000U;
+
+/** Pattern GetPattern() returned for JSON before JsonFormatter */
+constexpr const char* k_formerJsonPattern =
+    "{\"timestamp\":\"%Y-%m-%dT%H:%M:%S.%fZ\",\"level\":\"%^%l%$\","
+    "\"logger\":\"%n\",\"thread\":\"%t\",\"message\":\"%v\"}";
+
+/**
+ * @brief Time one formatter on a message
+ */
+double MeasureFormatterNs(spdlog::formatter& formatter,
+                          spdlog::string_view_t message) {
+    spdlog::details::log_msg msg(spdlog::source_loc{"bench.cpp", 42, "Run"},
+                                 "bench_json", spdlog::level::info, message);
+    const auto start = msg.time;
+    spdlog::memory_buf_t out;
+    return bench::MeasureNs(k_iterations, [&](std::uint64_t i) {
+        msg.time = start + std::chrono::microseconds(i);
+        out.clear();
+        formatter.format(msg, out);
+        bench::DoNotOptimize(out.data());
+    });
+}
+
+/**
+ * @brief Build a pattern formatter for a named pattern
+ */
+std::unique_ptr<spdlog::formatter> CreatePatternFormatter(
+    const std::string& name) {
+    std::string pattern;
+    static_cast<void>(formatters::GetPattern(name, pattern));
+    return std::make_unique<spdlog::pattern_formatter>(pattern);
+}
+
+} /* namespace */
+
+VSN_BENCH(json_formatter) {
+    std::unique_ptr<spdlog::formatter> json;
+    if (E_Result::E_SUCCESS !=
+        formatters::CreateJsonFormatter("bench_json", json)) {
+        return;
+    }
+    const auto text = CreatePatternFormatter("default");
+    const auto jsonPattern =
+        std::make_unique<spdlog::pattern_formatter>(k_formerJsonPattern);
+
+    const spdlog::string_view_t messages[] = {
+        "Request 1234 completed in 12 ms for user jdoe from 10.0.0.1",
+        "Payload rejected: \"name\" must not contain\n\ttabs or newlines"};
+    const char* const labels[] = {"plain message", "message with escapes"};
+
+    for (std::size_t m = 0U; m < 2U; ++m) {
+        const std::string suffix = std::string(", ") + labels[m];
+        const double textNanos = MeasureFormatterNs(*text, messages[m]);
+        const double jsonNanos = MeasureFormatterNs(*json, messages[m]);
+
+        bench::Report("default text pattern" + suffix, textNanos);
+        bench::Report("json pattern string (former)" + suffix,
+                      MeasureFormatterNs(*jsonPattern, messages[m]));
+        bench::Report("JsonFormatter" + suffix, jsonNanos);
+        bench::ReportRatio("text / JsonFormatter" + suffix, textNanos,
+                           jsonNanos);
+    }
+}
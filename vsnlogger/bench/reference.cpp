@@ -0,0 +1,209 @@
+/**
+ * @file reference.cpp
+ * @brief Former implementations kept as benchmark baselines
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include "reference.h"
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+#include "vsnlogger/clock.h"
+#include "vsnlogger/formatters.h"
+
+namespace vsn {
+namespace logger {
+namespace bench {
+
+E_Result ReferenceTimestamp(std::string& result) {
+    try {
+        auto now = std::chrono::system_clock::now();
+        auto timeT = std::chrono::system_clock::to_time_t(now);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      now.time_since_epoch()) %
+                  1000;
+
+        std::tm timeInfo;
+        if (nullptr == gmtime_r(&timeT, &timeInfo)) {
+            return E_Result::E_UNKNOWN_ERROR;
+        }
+
+        /* Format timestamp with stringstream for bounds safety */
+        std::stringstream ss;
+        ss << std::put_time(&timeInfo, "%Y-%m-%dT%H:%M:%S");
+        ss << '.' << std::setfill('0') << std::setw(3) << ms.count() << 'Z';
+
+        result = ss.str();
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+/* Helper function to JSON escape a string with bounds checking */
+static E_Result JsonEscapeString(const std::string& input,
+                                 std::string& output) {
+    try {
+        /* Reserve space to reduce allocations */
+        output.clear();
+        output.reserve(input.length() + 16U); /* Allow for some escaping */
+
+        for (std::size_t i = 0U; i < input.length(); ++i) {
+            const char c = input[i];
+            if (c == '\"') {
+                output += "\\\"";
+            } else if (c == '\\') {
+                output += "\\\\";
+            } else if (c == '\n') {
+                output += "\\n";
+            } else if (c == '\r') {
+                output += "\\r";
+            } else if (c == '\t') {
+                output += "\\t";
+            } else if (c == '\b') {
+                output += "\\b";
+            } else if (c == '\f') {
+                output += "\\f";
+            } else if (static_cast<unsigned char>(c) < 32U) {
+                /* Control characters as Unicode escapes */
+                char hexBuf[8];
+                std::snprintf(hexBuf, sizeof(hexBuf), "\\u%04x",
+                              static_cast<unsigned int>(c));
+                output += hexBuf;
+            } else {
+                output += c;
+            }
+        }
+
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_Result ReferenceToJson(
+    const std::string& message, const std::string& level,
+    const std::string& component,
+    const std::map<std::string, std::string>& additionalFields,
+    std::string& result) {
+    try {
+        /* Parameter validation */
+        if (message.empty() || level.empty()) {
+            return E_Result::E_INVALID_PARAMETER;
+        }
+
+        /* Get timestamp */
+        char timestamp[formatters::k_maxTimestampLength];
+        std::size_t timestampLength = 0U;
+        E_Result timestampResult = formatters::FormatTimestamp(
+            detail::ClockTicksToNanos(detail::ClockTicks()),
+            formatters::E_TimestampPrecision::E_MILLISECONDS, timestamp,
+            sizeof(timestamp), timestampLength);
+        if (E_Result::E_SUCCESS != timestampResult) {
+            return timestampResult;
+        }
+
+        /* Prepare JSON output with stringstream for bounds safety */
+        std::stringstream json;
+
+        /* Start JSON object */
+        json << "{";
+
+        /* Add standard fields */
+        json << "\"timestamp\":\"";
+        json.write(timestamp, static_cast<std::streamsize>(timestampLength));
+        json << "\",";
+        json << "\"level\":\"";
+
+        /* Escape level string */
+        std::string escapedLevel;
+        E_Result levelResult = JsonEscapeString(level, escapedLevel);
+        if (E_Result::E_SUCCESS != levelResult) {
+            return levelResult;
+        }
+        json << escapedLevel << "\",";
+
+        /* Add component if provided */
+        if (!component.empty()) {
+            json << "\"component\":\"";
+
+            /* Escape component string */
+            std::string escapedComponent;
+            E_Result componentResult =
+                JsonEscapeString(component, escapedComponent);
+            if (E_Result::E_SUCCESS != componentResult) {
+                return componentResult;
+            }
+            json << escapedComponent << "\",";
+        }
+
+        /* Add message */
+        json << "\"message\":\"";
+
+        /* Escape message string */
+        std::string escapedMessage;
+        E_Result messageResult = JsonEscapeString(message, escapedMessage);
+        if (E_Result::E_SUCCESS != messageResult) {
+            return messageResult;
+        }
+        json << escapedMessage << "\"";
+
+        /* Add additional fields with strict bounds checking */
+        if (!additionalFields.empty()) {
+            const std::size_t k_maxFields = 32U;
+            const std::size_t fieldCount =
+                (additionalFields.size() <= k_maxFields)
+                    ? additionalFields.size()
+                    : k_maxFields;
+
+            std::size_t processedFields = 0U;
+
+            for (const auto& field : additionalFields) {
+                if (processedFields >= fieldCount) {
+                    break;
+                }
+
+                json << ",\"";
+
+                /* Escape key string */
+                std::string escapedKey;
+                E_Result keyResult = JsonEscapeString(field.first, escapedKey);
+                if (E_Result::E_SUCCESS != keyResult) {
+                    continue;
+                }
+                json << escapedKey << "\":\"";
+
+                /* Escape value string */
+                std::string escapedValue;
+                E_Result valueResult =
+                    JsonEscapeString(field.second, escapedValue);
+                if (E_Result::E_SUCCESS != valueResult) {
+                    continue;
+                }
+                json << escapedValue << "\"";
+
+                ++processedFields;
+            }
+        }
+
+        /* Close JSON object */
+        json << "}";
+
+        /* Set result */
+        result = json.str();
+
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+} /* namespace bench */
+} /* namespace logger */
+} /* namespace vsn */
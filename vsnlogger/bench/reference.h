@@ -0,0 +1,54 @@
+/**
+ * @file reference.h
+ * @brief Former implementations kept as benchmark baselines
+ *
+ * @details
+ * These are the stringstream-based formatters as they were before being
+ * replaced, so the benchmarks keep measuring against the same baseline.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "error_codes.h"
+
+namespace vsn {
+namespace logger {
+namespace bench {
+
+/**
+ * @brief Render the current time with std::put_time()
+ *
+ * @param[out] result Timestamp, YYYY-MM-DDTHH:MM:SS.mmmZ
+ * @return Operation result code
+ */
+E_Result ReferenceTimestamp(std::string& result);
+
+/**
+ * @brief Format a JSON record through a std::stringstream
+ *
+ * @details
+ * The timestamp is rendered by FormatTimestamp(), as it was when ToJson()
+ * moved to JsonWriter, so only the JSON assembly differs.
+ *
+ * @param[in] message Log message content
+ * @param[in] level Severity level string
+ * @param[in] component Component identifier
+ * @param[in] additionalFields Additional key-value pairs to include
+ * @param[out] result Formatted output string
+ * @return Operation result code
+ */
+E_Result ReferenceToJson(
+    const std::string& message, const std::string& level,
+    const std::string& component,
+    const std::map<std::string, std::string>& additionalFields,
+    std::string& result);
+
+} /* namespace bench */
+} /* namespace logger */
+} /* namespace vsn */
@@ -0,0 +1,84 @@
+/**
+ * @file timestamp_bench.cpp
+ * @brief Timestamp rendering before and after the per-second cache
+ *
+ * @details
+ * The reference is the stringstream and std::put_time() rendering that
+ * FormatTimestamp() replaced. Both read the system clock; the remaining
+ * cases isolate formatting, with the second cached and with a new second
+ * on every call.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include <chrono>
+#include <string>
+
+#include "bench.h"
+#include "reference.h"
+#include "vsnlogger/formatters.h"
+
+using namespace vsn::logger;
+
+namespace {
+
+/** Calls per run */
+constexpr std::uint64_t k_iterations = 1000000U;
+
+/** Clock reading of the first formatted timestamp */
+constexpr std::uint64_t k_epochNanos = 1760000000000000000U;
+
+/**
+ * @brief Time FormatTimestamp() on readings step nanoseconds apart
+ */
+double MeasureFormatNs(formatters::E_TimestampPrecision precision,
+                       std::uint64_t step) {
+    char buffer[formatters::k_maxTimestampLength];
+    std::size_t length = 0U;
+    return bench::MeasureNs(k_iterations, [&](std::uint64_t i) {
+        bench::DoNotOptimize(formatters::FormatTimestamp(
+            k_epochNanos + (i * step), precision, buffer, sizeof(buffer),
+            length));
+        bench::DoNotOptimize(buffer);
+    });
+}
+
+} /* namespace */
+
+VSN_BENCH(timestamp_format) {
+    std::string text;
+    const double reference =
+        bench::MeasureNs(k_iterations, [&](std::uint64_t) {
+            bench::DoNotOptimize(bench::ReferenceTimestamp(text));
+        });
+
+    char buffer[formatters::k_maxTimestampLength];
+    std::size_t length = 0U;
+    const double current = bench::MeasureNs(k_iterations, [&](std::uint64_t) {
+        const auto now = std::chrono::system_clock::now().time_since_epoch();
+        bench::DoNotOptimize(formatters::FormatTimestamp(
+            static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(now)
+                    .count()),
+            formatters::E_TimestampPrecision::E_MILLISECONDS, buffer,
+            sizeof(buffer), length));
+        bench::DoNotOptimize(buffer);
+    });
+
+    bench::Report("stringstream + put_time, with clock (reference)",
+                  reference);
+    bench::Report("FormatTimestamp ms, with clock", current);
+    bench::ReportRatio("speedup, with clock", reference, current);
+
+    bench::Report("FormatTimestamp ms, same second",
+                  MeasureFormatNs(
+                      formatters::E_TimestampPrecision::E_MILLISECONDS, 1000U));
+    bench::Report("FormatTimestamp us, same second",
+                  MeasureFormatNs(
+                      formatters::E_TimestampPrecision::E_MICROSECONDS, 1000U));
+    bench::Report(
+        "FormatTimestamp ms, new second every call",
+        MeasureFormatNs(formatters::E_TimestampPrecision::E_MILLISECONDS,
+                        1000000001U));
+}
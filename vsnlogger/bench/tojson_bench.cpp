@@ -0,0 +1,74 @@
+/**
+ * @file tojson_bench.cpp
+ * @brief JSON record formatting through JsonWriter against a stringstream
+ *
+ * @details
+ * The record carries three additional fields, one of them needing escapes.
+ * Every ToJson() overload is measured against the stringstream
+ * implementation it replaced; the buffer overload reuses its buffer, as
+ * the per-thread wrappers do.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include <map>
+#include <string>
+
+#include "bench.h"
+#include "reference.h"
+#include "vsnlogger/formatters.h"
+
+using namespace vsn::logger;
+
+namespace {
+
+/** Calls per run */
+constexpr std::uint64_t k_iterations = 200000U;
+
+} /* namespace */
+
+VSN_BENCH(tojson_formatting) {
+    const std::string message = "Request completed in 12 ms";
+    const std::string level = "info";
+    const std::string component = "http";
+    const std::map<std::string, std::string> fieldMap = {
+        {"path", "/api/v1/users?id=42"},
+        {"request_id", "5f0c1a2b-7d3e"},
+        {"agent", "curl/8.0 \"test\"\n"}};
+    const JsonField_t fields[] = {{"path", "/api/v1/users?id=42"},
+                                  {"request_id", "5f0c1a2b-7d3e"},
+                                  {"agent", "curl/8.0 \"test\"\n"}};
+    const std::size_t fieldCount = sizeof(fields) / sizeof(fields[0]);
+
+    std::string result;
+    const double reference =
+        bench::MeasureNs(k_iterations, [&](std::uint64_t) {
+            bench::DoNotOptimize(bench::ReferenceToJson(
+                message, level, component, fieldMap, result));
+        });
+    const double mapFields =
+        bench::MeasureNs(k_iterations, [&](std::uint64_t) {
+            bench::DoNotOptimize(formatters::ToJson(message, level, component,
+                                                    fieldMap, result));
+        });
+    const double arrayFields =
+        bench::MeasureNs(k_iterations, [&](std::uint64_t) {
+            bench::DoNotOptimize(formatters::ToJson(
+                message, level, component, fields, fieldCount, result));
+        });
+    spdlog::memory_buf_t buffer;
+    const double reusedBuffer =
+        bench::MeasureNs(k_iterations, [&](std::uint64_t) {
+            buffer.clear();
+            bench::DoNotOptimize(formatters::ToJson(
+                message, level, component, fields, fieldCount, buffer));
+        });
+
+    bench::Report("stringstream, map fields (reference)", reference);
+    bench::Report("ToJson, map fields, std::string", mapFields);
+    bench::Report("ToJson, JsonField_t, std::string", arrayFields);
+    bench::Report("ToJson, JsonField_t, reused buffer", reusedBuffer);
+    bench::ReportRatio("speedup, map fields", reference, mapFields);
+    bench::ReportRatio("speedup, reused buffer", reference, reusedBuffer);
+}
@@ -0,0 +1,346 @@
+/**
+ * @file async.h
+ * @brief Asynchronous logging backend for VSNLogger
+ *
+ * @details
+ * This component moves pattern formatting and sink I/O off the calling
+ * thread. Records are copied either into one bounded queue shared by all
+ * producers, or into a lock-free ring owned by each producing thread that a
+ * single writer merges in timestamp order. Both are allocated up front and
+ * apply a selectable policy when full.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "error_codes.h"
+#include "vsnlogger/deferred.h"
+#include "vsnlogger/logger.h"
+
+/* Forward declaration of spdlog types */
+namespace spdlog {
+class formatter;
+namespace details {
+struct log_msg;
+}
+namespace sinks {
+class sink;
+}
+}  // namespace spdlog
+
+namespace vsn {
+namespace logger {
+namespace async {
+
+/**
+ * @brief Behaviour of the producer when the queue is full
+ */
+enum class E_OverflowPolicy : std::uint8_t {
+    E_BLOCK = 0U,           /**< Wait for a free slot */
+    E_DROP_NEWEST = 1U,     /**< Discard the incoming record */
+    E_DROP_OLDEST = 2U,     /**< Overwrite the oldest queued record */
+    E_DROP_BELOW_LEVEL = 3U /**< Discard records below a level, block others */
+};
+
+/**
+ * @brief Asynchronous mode settings
+ */
+struct AsyncOptions_t {
+    bool m_enabled;                    /**< Use the asynchronous backend */
+    std::uint32_t m_queueSize;         /**< Number of preallocated records */
+    std::uint8_t m_workerThreads;      /**< Number of writer threads */
+    E_OverflowPolicy m_overflowPolicy; /**< Full queue behaviour */
+    E_LogLevel m_dropBelowLevel;       /**< Threshold for E_DROP_BELOW_LEVEL */
+    bool m_deferredFormatting; /**< Capture raw arguments, format on writer */
+    bool m_perThreadQueues;    /**< One ring per producing thread */
+    std::uint32_t m_ringSize;  /**< Default records per thread ring */
+};
+
+/**
+ * @brief Snapshot of backend counters
+ */
+struct AsyncStats_t {
+    std::uint64_t m_enqueued;          /**< Records accepted into the queue */
+    std::uint64_t m_droppedNewest;     /**< Records discarded on arrival */
+    std::uint64_t m_droppedOldest;     /**< Queued records overwritten */
+    std::uint64_t m_droppedBelowLevel; /**< Records discarded by level */
+    std::uint64_t m_blocked;           /**< Producer waits on a full queue */
+};
+
+/**
+ * @brief Get default asynchronous mode settings (disabled)
+ *
+ * @return Default options
+ */
+AsyncOptions_t GetDefaultOptions(void);
+
+/**
+ * @brief Parse an overflow policy name
+ *
+ * @param[in] name One of block, drop_newest, drop_oldest, drop_below_level
+ * @param[out] policy Parsed policy
+ * @return Operation result code
+ */
+E_Result ParseOverflowPolicy(const std::string& name, E_OverflowPolicy& policy);
+
+/**
+ * @brief Name the class of the calling thread for per-thread ring sizing
+ *
+ * @details
+ * Rings are allocated on a thread's first log call, sized by the ring_size
+ * key of the [thread_class.<name>] configuration section, so the class must
+ * be set before the thread logs. Threads default to class "default".
+ *
+ * @param[in] name Thread class name, truncated to 31 characters
+ * @return Operation result code
+ */
+E_Result SetThreadClass(const std::string& name);
+
+/**
+ * @brief Single-producer ring owned by one logging thread
+ */
+struct ThreadRing_t;
+
+/**
+ * @brief Bounded queue with background writer threads feeding a sink set
+ *
+ * @details
+ * In per-thread mode worker_threads is ignored: a single writer merges the
+ * rings so output stays ordered by capture time.
+ */
+class AsyncBackend {
+   public:
+    /** Upper bound on the number of queued records */
+    static constexpr std::uint32_t k_maxQueueSize = 1048576U;
+
+    /** Upper bound on the number of writer threads */
+    static constexpr std::uint8_t k_maxWorkerThreads = 8U;
+
+    /**
+     * @brief Create backend and preallocate its queue
+     *
+     * @param[in] loggerName Name reported in dispatched records
+     * @param[in] sinks Destinations the writer threads dispatch to
+     * @param[in] options Queue size, thread count and overflow policy
+     */
+    AsyncBackend(const std::string& loggerName,
+                 std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks,
+                 const AsyncOptions_t& options);
+
+    /**
+     * @brief Drain the queue and join writer threads
+     */
+    ~AsyncBackend(void);
+
+    /* Disable copy and assignment */
+    AsyncBackend(const AsyncBackend&) = delete;
+    AsyncBackend& operator=(const AsyncBackend&) = delete;
+
+    /**
+     * @brief Start writer threads
+     *
+     * @return Operation result code
+     */
+    E_Result Start(void);
+
+    /**
+     * @brief Drain pending records and join writer threads
+     *
+     * @details
+     * Records submitted after Stop() are written on the calling thread.
+     *
+     * @return Operation result code
+     */
+    E_Result Stop(void);
+
+    /**
+     * @brief Copy a formatted record into the queue
+     *
+     * @param[in] msg Record as produced by the frontend logger
+     * @return Operation result code
+     */
+    E_Result Enqueue(const spdlog::details::log_msg& msg);
+
+    /**
+     * @brief Copy a prepared record into the queue
+     *
+     * @details
+     * Used for deferred records whose arguments are formatted by the
+     * writer thread through the record's decoder.
+     *
+     * @param[in] record Record staged by the producer
+     * @return Operation result code
+     */
+    E_Result Enqueue(const AsyncRecord_t& record);
+
+    /**
+     * @brief Wait until the queue is drained, then flush all sinks
+     *
+     * @return Operation result code
+     */
+    E_Result Flush(void);
+
+    /**
+     * @brief Install a copy of the formatter on every sink
+     *
+     * @param[in] formatter Formatter to clone
+     */
+    void SetFormatter(const spdlog::formatter& formatter);
+
+    /**
+     * @brief Allocate the calling thread's ring ahead of its first record
+     *
+     * @details
+     * Only meaningful in per-thread mode, where the ring would otherwise be
+     * allocated by the thread's first log call.
+     *
+     * @return Operation result code
+     */
+    E_Result PrepareThread(void);
+
+    /**
+     * @brief Set the length limit applied to deferred records
+     *
+     * @param[in] length Maximum message length in bytes
+     */
+    void SetMaxMessageLength(std::uint32_t length);
+
+    /**
+     * @brief Get a snapshot of the backend counters
+     *
+     * @return Counter values
+     */
+    AsyncStats_t GetStats(void) const;
+
+   private:
+    /**
+     * @brief Writer thread body for the shared queue
+     */
+    void WorkerLoop(void);
+
+    /**
+     * @brief Writer thread body merging per-thread rings
+     */
+    void MergeLoop(void);
+
+    /**
+     * @brief Write staged records of all rings in timestamp order
+     *
+     * @param[in,out] rings Snapshot of registered rings
+     * @param[in,out] scratch Buffer for decoding deferred arguments
+     * @return Number of records written
+     */
+    std::size_t MergeRings(std::vector<std::shared_ptr<ThreadRing_t>>& rings,
+                           spdlog::memory_buf_t& scratch);
+
+    /**
+     * @brief Copy a record into the calling thread's ring
+     *
+     * @param[in] record Record to copy
+     * @return Operation result code
+     */
+    E_Result PushThreadRing(const AsyncRecord_t& record);
+
+    /**
+     * @brief Get the calling thread's ring, allocating it on first use
+     *
+     * @return Ring of the calling thread or nullptr on allocation failure
+     */
+    ThreadRing_t* AcquireThreadRing(void);
+
+    /**
+     * @brief Drop drained rings of exited threads, keeping their counters
+     *
+     * @param[in,out] rings Snapshot of registered rings
+     */
+    void ReleaseRetiredRings(std::vector<std::shared_ptr<ThreadRing_t>>& rings);
+
+    /**
+     * @brief Write a record to every sink that accepts its level
+     *
+     * @param[in] record Record to write
+     * @param[in,out] scratch Buffer for decoding deferred arguments
+     * @return Operation result code
+     */
+    E_Result Dispatch(const AsyncRecord_t& record,
+                      spdlog::memory_buf_t& scratch);
+
+    /** Logger name reported in dispatched records */
+    const std::string m_loggerName;
+
+    /** Destinations written by the writer threads */
+    const std::vector<std::shared_ptr<spdlog::sinks::sink>> m_sinks;
+
+    /** Queue settings */
+    const AsyncOptions_t m_options;
+
+    /** Preallocated ring of records */
+    std::unique_ptr<AsyncRecord_t[]> m_records;
+
+    /** Ring capacity in records */
+    std::size_t m_capacity;
+
+    /** Index of the oldest queued record */
+    std::size_t m_head;
+
+    /** Number of queued records */
+    std::size_t m_count;
+
+    /** Records popped by a writer but not yet written */
+    std::size_t m_inFlight;
+
+    /** Writer threads run and producers enqueue while set */
+    std::atomic<bool> m_running;
+
+    /** Queue synchronization */
+    mutable std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+    std::condition_variable m_drained;
+
+    /** Unique identity, lets threads detect a replaced backend */
+    const std::uint64_t m_id;
+
+    /** Rings of all producing threads (per-thread mode) */
+    std::vector<std::shared_ptr<ThreadRing_t>> m_rings;
+
+    /** Bumped whenever m_rings changes */
+    std::atomic<std::uint64_t> m_ringsVersion;
+
+    /** Protects m_rings */
+    mutable std::mutex m_ringsMutex;
+
+    /** Set while the merging writer waits for records */
+    std::atomic<bool> m_writerIdle;
+
+    /** Threads waiting in Flush() (per-thread mode) */
+    std::atomic<std::uint32_t> m_flushWaiters;
+
+    /** Deferred records are truncated to this many bytes */
+    std::atomic<std::uint32_t> m_maxMessageLength;
+
+    /** Writer threads */
+    std::vector<std::thread> m_workers;
+
+    /** Counters */
+    std::atomic<std::uint64_t> m_enqueued;
+    std::atomic<std::uint64_t> m_droppedNewest;
+    std::atomic<std::uint64_t> m_droppedOldest;
+    std::atomic<std::uint64_t> m_droppedBelowLevel;
+    std::atomic<std::uint64_t> m_blocked;
+};
+
+} /* namespace async */
+} /* namespace logger */
+} /* namespace vsn */
@@ -0,0 +1,183 @@
+/**
+ * @file clock.h
+ * @brief Selectable timestamp source for VSNLogger records
+ *
+ * @details
+ * The logging thread stores raw ticks of the selected source in a record;
+ * they become wall time only where the record is written. Sources:
+ * - system: std::chrono::system_clock, the default
+ * - coarse: CLOCK_REALTIME_COARSE, cheaper to read but only as fine as the
+ *   kernel tick (1 to 4 ms)
+ * - tsc: the processor time stamp counter, mapped to wall time by a
+ *   calibration thread that re-anchors the mapping every second
+ *
+ * Ticks with the top bit set are TSC cycles, all others are nanoseconds
+ * since the epoch, so a record converts correctly even when the source
+ * changed after it was taken.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <spdlog/common.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define VSN_HAS_TSC 1
+#else
+#define VSN_HAS_TSC 0
+#endif
+
+#include "error_codes.h"
+
+namespace vsn {
+namespace logger {
+
+/**
+ * @brief Source of record timestamps
+ */
+enum class E_ClockSource : std::uint8_t {
+    E_SYSTEM = 0, /**< std::chrono::system_clock */
+    E_COARSE = 1, /**< CLOCK_REALTIME_COARSE */
+    E_TSC = 2     /**< Calibrated time stamp counter */
+};
+
+/** Marks ticks holding TSC cycles instead of nanoseconds */
+static constexpr std::uint64_t k_tscTickFlag = static_cast<std::uint64_t>(1U)
+                                               << 63U;
+
+/** Interval between TSC recalibrations */
+static constexpr std::uint32_t k_clockCalibrationMs = 1000U;
+
+namespace detail {
+
+/**
+ * @brief Selected source, read on every record
+ */
+extern std::atomic<E_ClockSource> g_clockSource;
+
+/**
+ * @brief System clock in nanoseconds since the epoch
+ */
+inline std::uint64_t SystemTicks(void) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+}
+
+/**
+ * @brief Read the selected source
+ *
+ * @return Raw ticks, converted by ClockTicksToTime()
+ */
+inline std::uint64_t ClockTicks(void) {
+    switch (g_clockSource.load(std::memory_order_relaxed)) {
+#if VSN_HAS_TSC
+        case E_ClockSource::E_TSC:
+            return __rdtsc() | k_tscTickFlag;
+#endif
+#ifdef CLOCK_REALTIME_COARSE
+        case E_ClockSource::E_COARSE: {
+            struct timespec now;
+            static_cast<void>(clock_gettime(CLOCK_REALTIME_COARSE, &now));
+            return (static_cast<std::uint64_t>(now.tv_sec) * 1000000000U) +
+                   static_cast<std::uint64_t>(now.tv_nsec);
+        }
+#endif
+        default:
+            return SystemTicks();
+    }
+}
+
+/**
+ * @brief Map TSC cycles to nanoseconds since the epoch
+ *
+ * @param[in] cycles Counter value without k_tscTickFlag
+ * @return Wall time under the latest calibration
+ */
+std::uint64_t TscToNanos(std::uint64_t cycles);
+
+/**
+ * @brief Convert ticks of any source to nanoseconds since the epoch
+ *
+ * @param[in] ticks Value from ClockTicks()
+ * @return Wall time in nanoseconds
+ */
+inline std::uint64_t ClockTicksToNanos(std::uint64_t ticks) {
+    return (0U != (ticks & k_tscTickFlag)) ? TscToNanos(ticks & ~k_tscTickFlag)
+                                           : ticks;
+}
+
+/**
+ * @brief Convert ticks of any source to a record timestamp
+ *
+ * @param[in] ticks Value from ClockTicks()
+ * @return Wall time as stored in spdlog messages
+ */
+inline spdlog::log_clock::time_point ClockTicksToTime(std::uint64_t ticks) {
+    return spdlog::log_clock::time_point(
+        std::chrono::duration_cast<spdlog::log_clock::duration>(
+            std::chrono::nanoseconds(
+                static_cast<std::int64_t>(ClockTicksToNanos(ticks)))));
+}
+
+/**
+ * @brief Convert a timestamp to nanosecond ticks
+ *
+ * @param[in] time Wall time
+ * @return Ticks accepted by ClockTicksToTime()
+ */
+inline std::uint64_t TimeToClockTicks(spdlog::log_clock::time_point time) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            time.time_since_epoch())
+            .count());
+}
+
+/**
+ * @brief Current time of the selected source
+ */
+inline spdlog::log_clock::time_point ClockNow(void) {
+    return ClockTicksToTime(ClockTicks());
+}
+
+} /* namespace detail */
+
+/**
+ * @brief Select the timestamp source
+ *
+ * @details
+ * Selecting the TSC calibrates it for about 20 ms and starts the
+ * calibration thread; selecting another source stops that thread.
+ *
+ * @param[in] source Timestamp source
+ * @return E_RESOURCE_UNAVAILABLE if the platform lacks the source (for the
+ *         TSC: no invariant counter), the previous source stays selected
+ */
+E_Result SetClockSource(E_ClockSource source);
+
+/**
+ * @brief Get the selected timestamp source
+ */
+E_ClockSource GetClockSource(void);
+
+/**
+ * @brief Parse a clock source name
+ *
+ * @param[in] name "system", "coarse" or "tsc"
+ * @param[out] source Parsed source
+ * @return Operation result code
+ */
+E_Result ParseClockSource(const std::string& name, E_ClockSource& source);
+
+} /* namespace logger */
+} /* namespace vsn */
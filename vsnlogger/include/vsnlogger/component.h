@@ -0,0 +1,258 @@
+/**
+ * @file component.h
+ * @brief Interned component handles for VSNLogger
+ *
+ * @details
+ * A component names the library or subsystem a record comes from. Each
+ * handle renders its "[name] " prefix at compile time and is interned into
+ * a fixed process-wide table on first use, which assigns a dense ID and
+ * keeps per-level record counters. Handles with the same name share one
+ * ID, so a component declared with VSN_DECLARE_COMPONENT and a string
+ * literal passed to VSN_COMPONENT_* count as the same component.
+ *
+ * Each ID also owns an atomic minimum level. Names are hierarchical
+ * ("net.http.client"); a level configured for "net" applies to every
+ * component below it unless a longer name has its own level. The most
+ * specific rule is resolved when a component is interned and again when
+ * the rules change, so the per-record check is one relaxed load.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "error_codes.h"
+
+namespace vsn {
+namespace logger {
+
+/* Severity levels, defined in logger.h */
+enum class E_LogLevel : std::uint8_t;
+
+/** Capacity of the component table, including the default entry */
+static constexpr std::uint32_t k_maxComponents = 256U;
+
+/** ID of records without a component, and of components past the limit */
+static constexpr std::uint32_t k_defaultComponent = 0U;
+
+/** Capacity of the component level rule table */
+static constexpr std::uint32_t k_maxComponentRules = 32U;
+
+/** Marker for a handle that has not been interned yet */
+static constexpr std::uint32_t k_unregisteredComponent = 0xFFFFFFFFU;
+
+/** Longest rendered prefix, longer names are cut */
+static constexpr std::size_t k_maxComponentPrefix = 48U;
+
+/** Number of severity levels counted per component (trace to critical) */
+static constexpr std::size_t k_componentLevelCount = 6U;
+
+namespace detail {
+
+/**
+ * @brief Minimum level of each component ID
+ *
+ * @details
+ * Entry k_defaultComponent holds the logger level. Zero-initialized, so
+ * all levels pass until a level is configured.
+ */
+extern std::atomic<std::uint8_t> g_componentLevels[k_maxComponents];
+
+} /* namespace detail */
+
+/**
+ * @brief Static handle naming a component
+ *
+ * @details
+ * Must have static storage duration. The constructor is constexpr, so
+ * handles are constant-initialized and need no guard.
+ */
+struct Component_t {
+    constexpr explicit Component_t(const char* name)
+        : m_name(name),
+          m_prefix{},
+          m_prefixLength(0U),
+          m_id(k_unregisteredComponent) {
+        if (nullptr != name) {
+            std::size_t length = 0U;
+            m_prefix[length++] = '[';
+            for (const char* p = name;
+                 ('\0' != *p) && (length < (k_maxComponentPrefix - 2U));
+                 ++p) {
+                m_prefix[length++] = *p;
+            }
+            m_prefix[length++] = ']';
+            m_prefix[length++] = ' ';
+            m_prefixLength = length;
+        }
+    }
+
+    /* Handles are identified by address */
+    Component_t(const Component_t&) = delete;
+    Component_t& operator=(const Component_t&) = delete;
+
+    /**
+     * @brief Get the interned ID, interning the handle on first use
+     *
+     * @return Dense component ID
+     */
+    std::uint32_t GetId(void);
+
+    const char* const m_name;           /**< Component name */
+    char m_prefix[k_maxComponentPrefix]; /**< Rendered "[name] " */
+    std::size_t m_prefixLength;          /**< Used prefix bytes */
+    std::atomic<std::uint32_t> m_id;     /**< Interned ID */
+};
+
+/**
+ * @brief Component argument of the VSN_COMPONENT_* macros
+ *
+ * @details
+ * Constant-initialized from either a declared handle or a string literal.
+ * A literal gets a handle embedded in the reference, so each macro
+ * expansion interns its component once.
+ */
+class ComponentRef_t {
+   public:
+    constexpr ComponentRef_t(const char* name)
+        : m_local(name), m_handle(nullptr) {}
+
+    constexpr ComponentRef_t(Component_t& handle)
+        : m_local(nullptr), m_handle(&handle) {}
+
+    /**
+     * @brief Get the referenced handle
+     *
+     * @return Declared handle or the embedded one
+     */
+    Component_t& Get(void) {
+        return (nullptr != m_handle) ? *m_handle : m_local;
+    }
+
+   private:
+    /** Handle for a literal component name */
+    Component_t m_local;
+
+    /** Declared handle, null for a literal */
+    Component_t* m_handle;
+};
+
+/**
+ * @brief Record counters of one component
+ */
+struct ComponentStats_t {
+    std::uint64_t m_records[k_componentLevelCount]; /**< By E_LogLevel */
+};
+
+/**
+ * @brief Callback receiving each interned component
+ */
+using ComponentVisitor_t = void (*)(std::uint32_t id, const char* name,
+                                    const ComponentStats_t& stats,
+                                    void* context);
+
+/**
+ * @brief Intern a handle by name
+ *
+ * @param[in,out] component Handle to intern
+ * @return Dense component ID, k_defaultComponent if the table is full
+ */
+std::uint32_t InternComponent(Component_t& component);
+
+/**
+ * @brief Count a record written for a component
+ *
+ * @param[in] id Interned component ID
+ * @param[in] level Severity of the record
+ */
+void CountComponentRecord(std::uint32_t id, E_LogLevel level);
+
+/**
+ * @brief Get the record counters of a component
+ *
+ * @param[in,out] component Handle of the component
+ * @param[out] stats Counter values
+ * @return Operation result code
+ */
+E_Result GetComponentStats(Component_t& component, ComponentStats_t& stats);
+
+/**
+ * @brief Visit every interned component
+ *
+ * @param[in] visitor Callback invoked once per component
+ * @param[in] context Opaque pointer handed to the visitor
+ * @return Operation result code
+ */
+E_Result EnumerateComponents(ComponentVisitor_t visitor, void* context);
+
+/**
+ * @brief Set the minimum level of a component and its descendants
+ *
+ * @param[in] name Component name, "net" also covers "net.http"
+ * @param[in] level Minimum severity logged for the component
+ * @return Operation result code
+ */
+E_Result ConfigureComponentLevel(const char* name, E_LogLevel level);
+
+/**
+ * @brief Drop all component level rules
+ *
+ * @return Operation result code
+ */
+E_Result ClearComponentLevels(void);
+
+/**
+ * @brief Set the level of records and components without a rule
+ *
+ * @param[in] level Minimum severity logged by default
+ * @return Operation result code
+ */
+E_Result ConfigureDefaultLevel(E_LogLevel level);
+
+/**
+ * @brief Get the lowest level any component currently accepts
+ *
+ * @details
+ * The backend logger must pass everything at this level so that records
+ * of components configured below the default level reach the sinks.
+ *
+ * @return Lowest configured level
+ */
+E_LogLevel GetComponentLevelFloor(void);
+
+/**
+ * @brief Check a severity against the level of a component
+ *
+ * @param[in] id Interned component ID
+ * @param[in] level Severity of the record
+ * @return true if the component accepts the record
+ */
+inline bool IsComponentLevelEnabled(std::uint32_t id, E_LogLevel level) {
+    return static_cast<std::uint8_t>(level) >=
+           detail::g_componentLevels[id].load(std::memory_order_relaxed);
+}
+
+inline std::uint32_t Component_t::GetId(void) {
+    const std::uint32_t id = m_id.load(std::memory_order_acquire);
+    return (k_unregisteredComponent != id) ? id : InternComponent(*this);
+}
+
+} /* namespace logger */
+} /* namespace vsn */
+
+/**
+ * @brief Declare a static component handle usable with VSN_COMPONENT_*
+ */
+#define VSN_DECLARE_COMPONENT(name) \
+    static ::vsn::logger::Component_t name(#name)
+
+/**
+ * @brief Declare a handle for a hierarchical name such as "net.http"
+ */
+#define VSN_DECLARE_COMPONENT_NAMED(handle, name) \
+    static ::vsn::logger::Component_t handle(name)
@@ -15,6 +15,7 @@
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "error_codes.h"
 
@@ -92,6 +93,27 @@ class LogConfig {
     E_Result Set(const std::string& section, const std::string& key,
                  const std::string& value);
 
+    /**
+     * @brief List the sections whose name starts with a prefix
+     *
+     * @param[in] prefix Section name prefix, e.g. "component."
+     * @param[out] sections Matching section names in sorted order
+     * @return Operation result code
+     */
+    E_Result GetSectionNames(const std::string& prefix,
+                             std::vector<std::string>& sections);
+
+    /**
+     * @brief Get a value stored in a section, without global fallback
+     *
+     * @param[in] section Configuration section identifier
+     * @param[in] key Configuration key
+     * @param[out] value Stored value
+     * @return E_SUCCESS, or E_INVALID_PARAMETER if the key is not set
+     */
+    E_Result GetSectionValue(const std::string& section,
+                             const std::string& key, std::string& value);
+
    private:
     /** Maximum number of configuration sections */
     static constexpr std::uint16_t k_maxSections = 32U;
@@ -0,0 +1,179 @@
+/**
+ * @file crash.h
+ * @brief Crash-surviving memory-mapped log ring for VSNLogger
+ *
+ * @details
+ * A crash ring is a file mapped shared into the process. Formatted records
+ * are copied into it with plain stores, so the normal write path performs
+ * no system call, and the kernel keeps the pages when the process dies.
+ * The crash handler only stores to the mapped header, which is
+ * async-signal-safe, then hands the signal back to the previous handler.
+ * After a restart RecoverCrashRing() or the vsnlogger_recover tool decodes
+ * the records in write order.
+ *
+ * File layout: a CrashRingHeader_t padded to k_crashRingHeaderSize bytes,
+ * followed by capacity bytes of ring data holding newline-terminated text.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "error_codes.h"
+
+namespace vsn {
+namespace logger {
+namespace crash {
+
+/** File identification, first 8 bytes of a ring file */
+static constexpr char k_crashRingMagic[8] = {'V', 'S', 'N', 'R',
+                                             'I', 'N', 'G', '1'};
+
+/** Layout version of CrashRingHeader_t */
+static constexpr std::uint32_t k_crashRingVersion = 1U;
+
+/** Bytes reserved for the header, ring data starts after them */
+static constexpr std::uint32_t k_crashRingHeaderSize = 4096U;
+
+/** Smallest and largest ring data size in bytes */
+static constexpr std::uint64_t k_minCrashRingSize = 4096U;
+static constexpr std::uint64_t k_maxCrashRingSize = 1024U * 1024U * 1024U;
+
+/** Number of rings the crash handler can mark at once */
+static constexpr std::uint32_t k_maxCrashRings = 8U;
+
+/**
+ * @brief Lifecycle of the process that owns a ring file
+ */
+enum class E_CrashRingState : std::uint32_t {
+    E_ACTIVE = 1U,  /**< Open, or the process died without a handler */
+    E_CLOSED = 2U,  /**< Closed cleanly */
+    E_CRASHED = 3U  /**< Marked by the crash handler */
+};
+
+/**
+ * @brief Header at the start of a ring file
+ */
+struct CrashRingHeader_t {
+    char m_magic[8];                 /**< k_crashRingMagic */
+    std::uint32_t m_version;         /**< k_crashRingVersion */
+    std::uint32_t m_headerSize;      /**< Offset of the ring data */
+    std::uint64_t m_capacity;        /**< Ring data size in bytes */
+    std::int64_t m_pid;              /**< Owning process */
+    std::int64_t m_startTime;        /**< Open time, seconds since epoch */
+    std::atomic<std::uint64_t> m_head;      /**< Bytes ever written */
+    std::atomic<std::uint32_t> m_state;     /**< E_CrashRingState */
+    std::atomic<std::int32_t> m_signal;     /**< Fatal signal, 0 if none */
+    std::atomic<std::uint64_t> m_crashHead; /**< m_head when marked */
+};
+
+static_assert(sizeof(CrashRingHeader_t) <= k_crashRingHeaderSize,
+              "Crash ring header must fit its reserved space");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "Crash ring counters must be lock-free to be signal-safe");
+
+/**
+ * @brief Ring file mapped into the process
+ *
+ * @details
+ * Not thread-safe: callers serialize Write(), as the sink lock does.
+ */
+class CrashRing {
+   public:
+    CrashRing(void);
+    ~CrashRing(void);
+
+    CrashRing(const CrashRing&) = delete;
+    CrashRing& operator=(const CrashRing&) = delete;
+
+    /**
+     * @brief Create and map a ring file
+     *
+     * @details
+     * An existing file is kept as path + ".prev" so the records of a
+     * crashed run survive the restart. The pages are populated up front,
+     * so later writes do not fault.
+     *
+     * @param[in] path Ring file path
+     * @param[in] capacity Ring data size in bytes, k_minCrashRingSize to
+     *            k_maxCrashRingSize
+     * @return Operation result code
+     */
+    E_Result Open(const std::string& path, std::uint64_t capacity);
+
+    /**
+     * @brief Copy bytes into the ring, overwriting the oldest data
+     *
+     * @param[in] data Bytes to copy
+     * @param[in] size Number of bytes
+     */
+    void Write(const char* data, std::size_t size);
+
+    /**
+     * @brief Mark the ring closed cleanly and unmap it
+     */
+    void Close(void);
+
+   private:
+    /** Mapped header, nullptr while closed */
+    CrashRingHeader_t* m_header;
+
+    /** Mapped ring data */
+    char* m_data;
+
+    /** Mapping length including the header */
+    std::size_t m_mappedSize;
+
+    /** Slot in the crash handler's table */
+    std::uint32_t m_slot;
+};
+
+/**
+ * @brief Decoded contents of a ring file
+ */
+struct CrashRingInfo_t {
+    E_CrashRingState m_state; /**< State recorded in the file */
+    std::int32_t m_signal;    /**< Fatal signal, 0 if none */
+    std::int64_t m_pid;       /**< Owning process */
+    std::int64_t m_startTime; /**< Open time, seconds since epoch */
+    std::uint64_t m_written;  /**< Bytes ever written */
+    bool m_wrapped;           /**< Oldest records were overwritten */
+};
+
+/**
+ * @brief Mark open rings when the process receives a fatal signal
+ *
+ * @details
+ * Handles SIGSEGV, SIGBUS, SIGFPE, SIGILL and SIGABRT. The handler records
+ * the signal and the ring tail, restores the previous action and raises
+ * the signal again, so core dumps and other handlers still run. Calling
+ * it again has no effect.
+ *
+ * @return Operation result code
+ */
+E_Result InstallCrashHandler(void);
+
+/**
+ * @brief Decode a ring file
+ *
+ * @details
+ * Records are returned oldest first. When the ring wrapped, the partial
+ * record at the start of the ring is dropped.
+ *
+ * @param[in] path Ring file path
+ * @param[out] text Records in write order
+ * @param[out] info Header fields
+ * @return Operation result code, E_FILE_ERROR if the file cannot be read
+ *         and E_INVALID_PARAMETER if it is not a ring file
+ */
+E_Result RecoverCrashRing(const std::string& path, std::string& text,
+                          CrashRingInfo_t& info);
+
+} /* namespace crash */
+} /* namespace logger */
+} /* namespace vsn */
@@ -0,0 +1,319 @@
+/**
+ * @file deferred.h
+ * @brief Deferred argument capture for asynchronous logging
+ *
+ * @details
+ * This component lets the calling thread copy raw argument bytes into a
+ * fixed-size record instead of formatting the message. The writer thread
+ * later decodes the bytes and runs the format string. Arithmetic and enum
+ * arguments are copied by value, string arguments are copied inline; any
+ * other argument type makes the call fall back to eager formatting. Records
+ * from the logging macros carry a decoder bound to the pre-compiled format,
+ * so the writer does not parse the format string either. A run-time format
+ * string may be gone by the time the writer runs, so it is copied into the
+ * record behind the arguments.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <spdlog/common.h>
+#include <spdlog/details/os.h>
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "vsnlogger/clock.h"
+#include "vsnlogger/format.h"
+
+namespace vsn {
+namespace logger {
+
+/* Interned component handle, defined in component.h */
+struct Component_t;
+
+namespace async {
+
+/** Maximum payload stored per record, longer formatted text truncates */
+static constexpr std::size_t k_maxRecordPayload = 512U;
+
+/**
+ * @brief Decoder rendering the argument bytes of a deferred record
+ */
+using DecodeFn_t = void (*)(const char* format, const unsigned char* data,
+                            spdlog::memory_buf_t& out);
+
+/**
+ * @brief Record exchanged between producers and writer threads
+ */
+struct AsyncRecord_t {
+    std::uint64_t m_ticks;                /**< Capture time, see clock.h */
+    spdlog::source_loc m_source;          /**< Call site */
+    std::size_t m_threadId;               /**< Producing thread */
+    spdlog::level::level_enum m_level;    /**< Severity */
+    const Component_t* m_component;       /**< Prefixed component or null */
+    std::uint64_t m_suppressed;           /**< Rate-limited calls before */
+    DecodeFn_t m_decode;  /**< Null when the payload is formatted text */
+    const char* m_format; /**< Static format string, null if in payload */
+    std::uint16_t m_size; /**< Used payload bytes */
+    unsigned char m_payload[k_maxRecordPayload]; /**< Text or argument bytes */
+};
+
+namespace detail {
+
+/** Size reported for arguments that cannot be captured */
+static constexpr std::size_t k_unencodable = k_maxRecordPayload + 1U;
+
+/**
+ * @brief Codec for argument types without deferred support
+ */
+template <typename T, typename Enable = void>
+struct ArgCodec_t {
+    static constexpr bool k_supported = false;
+};
+
+/**
+ * @brief Codec copying arithmetic and enum values by value
+ */
+template <typename T>
+struct ArgCodec_t<
+    T, typename std::enable_if<std::is_arithmetic<T>::value ||
+                               std::is_enum<T>::value>::type> {
+    static constexpr bool k_supported = true;
+
+    using Decoded_t = T;
+
+    static std::size_t Size(const T& value) {
+        static_cast<void>(value);
+        return sizeof(T);
+    }
+
+    static unsigned char* Encode(unsigned char* out, const T& value) {
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    }
+
+    static Decoded_t Decode(const unsigned char*& in) {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+        return value;
+    }
+};
+
+/**
+ * @brief Codec copying string contents inline, prefixed by their length
+ */
+template <typename T>
+struct StringCodec_t {
+    static constexpr bool k_supported = true;
+
+    using Decoded_t = spdlog::string_view_t;
+
+    static std::size_t Size(const T& value) {
+        if (!IsValid(value)) {
+            return k_unencodable;
+        }
+        const std::size_t length = View(value).size();
+        return (length < k_maxRecordPayload)
+                   ? sizeof(std::uint32_t) + length
+                   : k_unencodable;
+    }
+
+    static unsigned char* Encode(unsigned char* out, const T& value) {
+        const std::string_view view = View(value);
+        const std::uint32_t length = static_cast<std::uint32_t>(view.size());
+        std::memcpy(out, &length, sizeof(length));
+        out += sizeof(length);
+        if (length > 0U) {
+            std::memcpy(out, view.data(), length);
+        }
+        return out + length;
+    }
+
+    static Decoded_t Decode(const unsigned char*& in) {
+        std::uint32_t length = 0U;
+        std::memcpy(&length, in, sizeof(length));
+        in += sizeof(length);
+        const char* data = reinterpret_cast<const char*>(in);
+        in += length;
+        return Decoded_t(data, length);
+    }
+
+   private:
+    static bool IsValid(const T& value) {
+        if constexpr (std::is_pointer<T>::value) {
+            return nullptr != value;
+        } else {
+            static_cast<void>(value);
+            return true;
+        }
+    }
+
+    static std::string_view View(const T& value) {
+        if constexpr (std::is_array<T>::value) {
+            /* Character arrays end at the first terminator or their extent */
+            const std::string_view whole(value, std::extent<T>::value);
+            return whole.substr(0U, whole.find('\0'));
+        } else {
+            return std::string_view(value);
+        }
+    }
+};
+
+template <>
+struct ArgCodec_t<const char*> : StringCodec_t<const char*> {};
+
+template <>
+struct ArgCodec_t<char*> : StringCodec_t<const char*> {};
+
+template <std::size_t N>
+struct ArgCodec_t<char[N]> : StringCodec_t<char[N]> {};
+
+template <>
+struct ArgCodec_t<std::string> : StringCodec_t<std::string> {};
+
+template <>
+struct ArgCodec_t<std::string_view> : StringCodec_t<std::string_view> {};
+
+/**
+ * @brief Codec for an argument as passed to the logging call
+ */
+template <typename T>
+using CodecFor_t = ArgCodec_t<typename std::remove_cv<T>::type>;
+
+/**
+ * @brief True if every argument type can be captured without formatting
+ */
+template <typename... Args>
+struct IsDeferrable
+    : std::integral_constant<bool, (CodecFor_t<Args>::k_supported && ...)> {};
+
+/**
+ * @brief Decode argument bytes and format them into the output buffer
+ */
+template <typename Format, typename... Args>
+void DecodeAndFormat(const char* format, const unsigned char* data,
+                     spdlog::memory_buf_t& out) {
+    const unsigned char* cursor = data;
+    static_cast<void>(cursor);
+
+    /* Braced initialization decodes arguments left to right */
+    const std::tuple<typename CodecFor_t<Args>::Decoded_t...> values{
+        CodecFor_t<Args>::Decode(cursor)...};
+
+    if constexpr (std::is_same<Format,
+                               logger::detail::RuntimeFormat_t>::value) {
+        /* The copied format string follows the arguments */
+        static_cast<void>(format);
+        const char* const text = reinterpret_cast<const char*>(cursor);
+        const std::size_t start = out.size();
+        try {
+            std::apply(
+                [text, &out](const auto&... value) {
+                    logger::detail::FormatValues(out, Format(), text,
+                                                 value...);
+                },
+                values);
+        } catch (...) {
+            /* Emit the raw format string rather than losing the record */
+            out.resize(start);
+            out.append(text, text + std::strlen(text));
+        }
+    } else {
+        std::apply(
+            [format, &out](const auto&... value) {
+                logger::detail::FormatValues(out, Format(), format, value...);
+            },
+            values);
+    }
+}
+
+/**
+ * @brief Capture format string and argument bytes into a record
+ *
+ * @tparam Format Compiled format type, or RuntimeFormat_t to parse the
+ *         format string on the writer; the string is then copied as well
+ * @return false if the arguments do not fit, the record is left unusable
+ */
+template <typename Format, typename... Args>
+bool EncodeArgs(AsyncRecord_t& record, const char* format,
+                const Args&... args) {
+    constexpr bool k_copyFormat =
+        std::is_same<Format, logger::detail::RuntimeFormat_t>::value;
+    const std::size_t argsSize =
+        (static_cast<std::size_t>(0U) + ... + CodecFor_t<Args>::Size(args));
+    const std::size_t formatSize =
+        k_copyFormat ? (std::strlen(format) + 1U) : 0U;
+    if ((argsSize > k_maxRecordPayload) ||
+        (formatSize > (k_maxRecordPayload - argsSize))) {
+        return false;
+    }
+
+    unsigned char* cursor = record.m_payload;
+    static_cast<void>(cursor);
+    ((cursor = CodecFor_t<Args>::Encode(cursor, args)), ...);
+    if constexpr (k_copyFormat) {
+        std::memcpy(cursor, format, formatSize);
+    }
+
+    record.m_decode = &DecodeAndFormat<Format, Args...>;
+    record.m_format = k_copyFormat ? nullptr : format;
+    record.m_size = static_cast<std::uint16_t>(argsSize + formatSize);
+    return true;
+}
+
+/**
+ * @brief Per-thread staging record for deferred capture
+ */
+inline AsyncRecord_t& StagingRecord(void) {
+    static thread_local AsyncRecord_t t_record;
+    return t_record;
+}
+
+/**
+ * @brief Id of the calling thread, asked of the system once per thread
+ */
+inline std::size_t ThreadId(void) {
+    static thread_local const std::size_t t_threadId =
+        spdlog::details::os::thread_id();
+    return t_threadId;
+}
+
+} /* namespace detail */
+
+/**
+ * @brief Copy the used part of a record
+ *
+ * @param[in] from Source record
+ * @param[out] to Destination record
+ */
+void CopyRecord(const AsyncRecord_t& from, AsyncRecord_t& to);
+
+/**
+ * @brief Render the message text of a record
+ *
+ * @details
+ * Deferred records are decoded into scratch behind their component prefix,
+ * cut to limit and followed by the suppressed-call note. Text records are
+ * returned as stored.
+ *
+ * @param[in] record Record to render
+ * @param[in] limit Maximum length of decoded text
+ * @param[in,out] scratch Buffer for decoding deferred arguments
+ * @return Message text, valid until scratch or record change
+ */
+spdlog::string_view_t RenderRecord(const AsyncRecord_t& record,
+                                   std::size_t limit,
+                                   spdlog::memory_buf_t& scratch);
+
+} /* namespace async */
+} /* namespace logger */
+} /* namespace vsn */
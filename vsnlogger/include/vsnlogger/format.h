@@ -0,0 +1,213 @@
+/**
+ * @file format.h
+ * @brief Bounded message formatting for VSNLogger
+ *
+ * @details
+ * This component renders log messages into a fixed-size buffer owned by the
+ * calling thread. Output longer than the logger's message limit is cut at a
+ * character boundary and ends with a truncation marker, so formatting never
+ * allocates and a message never exceeds its configured size.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <spdlog/common.h>
+#include <spdlog/fmt/compile.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace vsn {
+namespace logger {
+
+/** Largest configurable message length, size of the per-thread buffer */
+static constexpr std::size_t k_maxMessageBuffer = 4096U;
+
+/** Text ending a message cut at the length limit */
+static constexpr char k_truncationMarker[] = "...[truncated]";
+
+/** Length of the truncation marker */
+static constexpr std::size_t k_truncationMarkerLength =
+    sizeof(k_truncationMarker) - 1U;
+
+namespace detail {
+
+/**
+ * @brief Marker selecting run-time parsing of the format string
+ */
+struct RuntimeFormat_t {};
+
+/**
+ * @brief Format values with either a compiled or a run-time format
+ *
+ * @param[out] out Buffer receiving the text
+ * @param[in] format Compiled format object or RuntimeFormat_t
+ * @param[in] text Format string, parsed only for RuntimeFormat_t
+ */
+template <typename Format, typename... Values>
+void FormatValues(spdlog::memory_buf_t& out, const Format& format,
+                  const char* text, const Values&... values) {
+    if constexpr (std::is_same<Format, RuntimeFormat_t>::value) {
+        static_cast<void>(format);
+        fmt::vformat_to(std::back_inserter(out), fmt::string_view(text),
+                        fmt::make_format_args(values...));
+    } else {
+        static_cast<void>(text);
+        fmt::format_to(std::back_inserter(out), format, values...);
+    }
+}
+
+/**
+ * @brief End an over-long message with the truncation marker
+ *
+ * @details
+ * The cut is moved back to the start of a UTF-8 sequence so the marker
+ * never splits a multi-byte character.
+ *
+ * @param[in,out] data Message text, at least limit bytes long
+ * @param[in] limit Maximum message length including the marker
+ * @return Length of the truncated message
+ */
+inline std::size_t MarkTruncated(char* data, std::size_t limit) {
+    if (limit <= k_truncationMarkerLength) {
+        return limit;
+    }
+
+    std::size_t cut = limit - k_truncationMarkerLength;
+    while ((cut > 0U) &&
+           (0x80U == (static_cast<unsigned char>(data[cut]) & 0xC0U))) {
+        --cut;
+    }
+
+    std::memcpy(data + cut, k_truncationMarker, k_truncationMarkerLength);
+    return cut + k_truncationMarkerLength;
+}
+
+/**
+ * @brief Append the count of suppressed records to a message
+ *
+ * @details
+ * The note always fits: a message that would exceed the limit with it is
+ * truncated further to make room.
+ *
+ * @param[in,out] data Message text, with room for limit bytes
+ * @param[in] size Current message length
+ * @param[in] limit Maximum message length including the note
+ * @param[in] suppressed Number of records suppressed at the call site
+ * @return Length of the message with the note
+ */
+inline std::size_t AppendSuppressed(char* data, std::size_t size,
+                                    std::size_t limit,
+                                    std::uint64_t suppressed) {
+    char note[48];
+    const std::size_t length = static_cast<std::size_t>(
+        fmt::format_to_n(note, sizeof(note), " [{} suppressed]", suppressed)
+            .size);
+
+    if (length >= limit) {
+        return size;
+    }
+    if (size + length > limit) {
+        size = MarkTruncated(data, limit - length);
+    }
+
+    std::memcpy(data + size, note, length);
+    return size + length;
+}
+
+/**
+ * @brief Output iterator filling a fixed range, dropping what does not fit
+ *
+ * @details
+ * Only public fmt interfaces accept it, unlike fmt's internal fixed
+ * buffers. Two pointers keep it in registers across fmt's calls; a range
+ * one character longer than the limit tells whether the text was cut.
+ */
+struct BoundedIterator_t {
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    char* m_out; /**< Next character to write */
+    char* m_end; /**< End of the range */
+
+    BoundedIterator_t& operator*(void) { return *this; }
+    BoundedIterator_t& operator++(void) { return *this; }
+    BoundedIterator_t& operator++(int) { return *this; }
+
+    BoundedIterator_t& operator=(char value) {
+        if (m_out != m_end) {
+            *m_out++ = value;
+        }
+        return *this;
+    }
+};
+
+/**
+ * @brief Per-thread buffer receiving formatted messages
+ */
+inline char* MessageBuffer(void) {
+    /* One spare character detects truncation at the largest limit */
+    static thread_local char t_buffer[k_maxMessageBuffer + 1U];
+    return t_buffer;
+}
+
+/**
+ * @brief Format into the calling thread's buffer, truncating at a limit
+ *
+ * @details
+ * A pre-rendered prefix is copied verbatim ahead of the formatted text and
+ * counts towards the limit.
+ *
+ * @param[in] limit Maximum message length, at most k_maxMessageBuffer
+ * @param[in] prefix Text placed before the message, may be null
+ * @param[in] prefixLength Length of prefix
+ * @param[in] format Compiled format object or RuntimeFormat_t
+ * @param[in] text Format string, parsed only for RuntimeFormat_t
+ * @return View of the message, valid until the thread formats again
+ */
+template <typename Format, typename... Values>
+spdlog::string_view_t FormatBounded(std::size_t limit, const char* prefix,
+                                    std::size_t prefixLength,
+                                    const Format& format, const char* text,
+                                    const Values&... values) {
+    char* const buffer = MessageBuffer();
+    std::size_t size = 0U;
+
+    if (nullptr != prefix) {
+        size = std::min(prefixLength, limit);
+        std::memcpy(buffer, prefix, size);
+    }
+
+    if constexpr (std::is_same<Format, RuntimeFormat_t>::value) {
+        static_cast<void>(format);
+        size += fmt::vformat_to_n(buffer + size, limit - size,
+                                  fmt::string_view(text),
+                                  fmt::make_format_args(values...))
+                    .size;
+    } else {
+        static_cast<void>(text);
+        const BoundedIterator_t out{buffer + size, buffer + limit + 1U};
+        size = static_cast<std::size_t>(
+            fmt::format_to(out, format, values...).m_out - buffer);
+    }
+
+    if (size > limit) {
+        size = MarkTruncated(buffer, limit);
+    }
+
+    return spdlog::string_view_t(buffer, size);
+}
+
+} /* namespace detail */
+} /* namespace logger */
+} /* namespace vsn */
@@ -12,11 +12,18 @@
 
 #pragma once
 
+#include <spdlog/common.h>
+#include <spdlog/formatter.h>
+
+#include <cstddef>
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
+#include <string_view>
 
 #include "error_codes.h"
+#include "vsnlogger/json.h"
 
 namespace vsn {
 namespace logger {
@@ -35,6 +42,38 @@ enum class E_FormatType : std::uint8_t {
     E_DEFAULT = 6U
 };
 
+/**
+ * @brief Fraction digits of a rendered timestamp
+ */
+enum class E_TimestampPrecision : std::uint8_t {
+    E_MILLISECONDS = 0U, /**< YYYY-MM-DDTHH:MM:SS.mmmZ */
+    E_MICROSECONDS = 1U  /**< YYYY-MM-DDTHH:MM:SS.uuuuuuZ */
+};
+
+/** Additional JSON fields written per record, extra ones are dropped */
+static constexpr std::size_t k_maxJsonFields = 32U;
+
+/** Buffer size holding a timestamp of any precision */
+static constexpr std::size_t k_maxTimestampLength = 27U;
+
+/**
+ * @brief Render an ISO-8601 UTC timestamp into a caller buffer
+ *
+ * @details
+ * The "YYYY-MM-DDTHH:MM:SS" part is cached per thread and rebuilt only
+ * when the second changes; otherwise only the fraction digits are written.
+ * The text is not terminated.
+ *
+ * @param[in] nanos Nanoseconds since the epoch
+ * @param[in] precision Fraction digits
+ * @param[out] buffer Destination of at least size bytes
+ * @param[in] size Buffer size, k_maxTimestampLength always suffices
+ * @param[out] length Characters written
+ * @return Operation result code
+ */
+E_Result FormatTimestamp(std::uint64_t nanos, E_TimestampPrecision precision,
+                         char* buffer, std::size_t size, std::size_t& length);
+
 /**
  * @brief Format log entry as JSON
  *
@@ -47,6 +86,40 @@ enum class E_FormatType : std::uint8_t {
 E_Result ToJson(const std::string& message, const std::string& level,
                 const std::string& component, std::string& result);
 
+/**
+ * @brief Format log entry as JSON into a caller buffer
+ *
+ * @details
+ * Appends to the buffer without intermediate strings, so a reused buffer
+ * makes formatting allocation-free.
+ *
+ * @param[in] message Log message content
+ * @param[in] level Severity level string
+ * @param[in] component Component identifier, omitted when empty
+ * @param[in] fields Additional string fields, at most k_maxJsonFields used
+ * @param[in] fieldCount Number of additional fields
+ * @param[out] out Buffer receiving the JSON object
+ * @return Operation result code
+ */
+E_Result ToJson(std::string_view message, std::string_view level,
+                std::string_view component, const JsonField_t* fields,
+                std::size_t fieldCount, spdlog::memory_buf_t& out);
+
+/**
+ * @brief Format log entry as JSON with additional fields
+ *
+ * @param[in] message Log message content
+ * @param[in] level Severity level string
+ * @param[in] component Component identifier
+ * @param[in] fields Additional string fields
+ * @param[in] fieldCount Number of additional fields
+ * @param[out] result Formatted output string
+ * @return Operation result code
+ */
+E_Result ToJson(const std::string& message, const std::string& level,
+                const std::string& component, const JsonField_t* fields,
+                std::size_t fieldCount, std::string& result);
+
 /**
  * @brief Format log entry as JSON with additional fields
  *
@@ -86,9 +159,64 @@ E_Result ToSyslog(const std::string& message, const std::string& level,
 E_Result ToConsole(const std::string& message, const std::string& level,
                    const std::string& component, std::string& result);
 
+/**
+ * @brief spdlog formatter writing each record as one JSON object per line
+ *
+ * @details
+ * Writes timestamp (UTC, microseconds), level, logger, thread and message,
+ * followed by the static fields, escaping the message in one pass straight
+ * into the sink's buffer. Static fields are serialized once when added.
+ */
+class JsonFormatter final : public spdlog::formatter {
+   public:
+    JsonFormatter(void) = default;
+
+    /**
+     * @brief Add a field written unchanged with every record
+     *
+     * @param[in] key Field name
+     * @param[in] value String value
+     */
+    void AddStaticField(std::string_view key, std::string_view value);
+
+    /**
+     * @brief Add a numeric field written unchanged with every record
+     *
+     * @param[in] key Field name
+     * @param[in] value Integer value
+     */
+    void AddStaticField(std::string_view key, std::int64_t value);
+
+    void format(const spdlog::details::log_msg& msg,
+                spdlog::memory_buf_t& dest) override;
+
+    std::unique_ptr<spdlog::formatter> clone(void) const override;
+
+   private:
+    /** Static fields serialized as "key":value pairs */
+    spdlog::memory_buf_t m_staticFields;
+
+    /** Number of static fields */
+    std::uint32_t m_staticFieldCount = 0U;
+};
+
+/**
+ * @brief Create the JSON formatter with app, pid and host static fields
+ *
+ * @param[in] appName Application name written as "app"
+ * @param[out] formatter Created formatter
+ * @return Operation result code
+ */
+E_Result CreateJsonFormatter(const std::string& appName,
+                             std::unique_ptr<spdlog::formatter>& formatter);
+
 /**
  * @brief Get spdlog pattern string for specified format
  *
+ * @details
+ * A pattern cannot escape the message, so E_JSON has none and fails with
+ * E_INVALID_PARAMETER; CreateFormatter() returns a JsonFormatter for it.
+ *
  * @param[in] formatType Format type identifier
  * @param[out] pattern Pattern string for spdlog
  * @return Operation result code
@@ -98,12 +226,35 @@ E_Result GetPattern(E_FormatType formatType, std::string& pattern);
 /**
  * @brief Get spdlog pattern string for specified format name
  *
- * @param[in] formatName Format name string
+ * @param[in] formatName Format name string, unknown names get the default
  * @param[out] pattern Pattern string for spdlog
- * @return Operation result code
+ * @return Operation result code, E_INVALID_PARAMETER for "json"
  */
 E_Result GetPattern(const std::string& formatName, std::string& pattern);
 
+/**
+ * @brief Create the formatter of a format type
+ *
+ * @param[in] formatType Format type identifier
+ * @param[in] appName Application name, written by the JSON formatter
+ * @param[out] formatter JsonFormatter for E_JSON, else a pattern formatter
+ * @return Operation result code
+ */
+E_Result CreateFormatter(E_FormatType formatType, const std::string& appName,
+                         std::unique_ptr<spdlog::formatter>& formatter);
+
+/**
+ * @brief Create the formatter of a format name
+ *
+ * @param[in] formatName Format name string, unknown names get the default
+ * @param[in] appName Application name, written by the JSON formatter
+ * @param[out] formatter JsonFormatter for "json", else a pattern formatter
+ * @return Operation result code
+ */
+E_Result CreateFormatter(const std::string& formatName,
+                         const std::string& appName,
+                         std::unique_ptr<spdlog::formatter>& formatter);
+
 } /* namespace formatters */
 } /* namespace logger */
 } /* namespace vsn */
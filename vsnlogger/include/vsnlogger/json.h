@@ -0,0 +1,223 @@
+/**
+ * @file json.h
+ * @brief Streaming JSON writer for VSNLogger
+ *
+ * @details
+ * Appends one JSON object to a caller-owned buffer, escaping keys and
+ * values on the way, without intermediate strings. Reusing the buffer
+ * across records makes writing allocation-free once it has grown to the
+ * largest record.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <spdlog/common.h>
+
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace vsn {
+namespace logger {
+
+/**
+ * @brief Key and string value of one JSON field
+ */
+struct JsonField_t {
+    std::string_view m_key;   /**< Field name, escaped when written */
+    std::string_view m_value; /**< String value, escaped when written */
+};
+
+/**
+ * @brief Writer appending one JSON object to a buffer
+ */
+class JsonWriter {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param[out] out Buffer receiving the object, appended to
+     */
+    explicit JsonWriter(spdlog::memory_buf_t& out)
+        : m_out(out), m_fieldCount(0U) {}
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    /**
+     * @brief Open the object
+     */
+    void BeginObject(void) {
+        m_out.push_back('{');
+        m_fieldCount = 0U;
+    }
+
+    /**
+     * @brief Continue an object whose first fields were appended directly
+     *
+     * @details
+     * The next field is written with a leading separator.
+     */
+    void ContinueObject(void) { m_fieldCount = 1U; }
+
+    /**
+     * @brief Close the object
+     */
+    void EndObject(void) { m_out.push_back('}'); }
+
+    /**
+     * @brief Add a field with a string value
+     *
+     * @param[in] key Field name
+     * @param[in] value Field value
+     */
+    void AddString(std::string_view key, std::string_view value) {
+        AddKey(key);
+        m_out.push_back('"');
+        AppendEscaped(value, m_out);
+        m_out.push_back('"');
+    }
+
+    /**
+     * @brief Add a field with a signed integer value
+     *
+     * @param[in] key Field name
+     * @param[in] value Field value
+     */
+    void AddInteger(std::string_view key, std::int64_t value) {
+        const fmt::format_int digits(value);
+        AddRaw(key, std::string_view(digits.data(), digits.size()));
+    }
+
+    /**
+     * @brief Add a field with an unsigned integer value
+     *
+     * @param[in] key Field name
+     * @param[in] value Field value
+     */
+    void AddUnsigned(std::string_view key, std::uint64_t value) {
+        const fmt::format_int digits(value);
+        AddRaw(key, std::string_view(digits.data(), digits.size()));
+    }
+
+    /**
+     * @brief Add a field with a floating point value, null if not finite
+     *
+     * @param[in] key Field name
+     * @param[in] value Field value
+     */
+    void AddDouble(std::string_view key, double value) {
+        AddKey(key);
+        if (std::isfinite(value)) {
+            fmt::format_to(std::back_inserter(m_out), "{}", value);
+        } else {
+            m_out.append(k_null, k_null + sizeof(k_null) - 1U);
+        }
+    }
+
+    /**
+     * @brief Add a field with a boolean value
+     *
+     * @param[in] key Field name
+     * @param[in] value Field value
+     */
+    void AddBool(std::string_view key, bool value) {
+        AddRaw(key,
+               value ? std::string_view("true") : std::string_view("false"));
+    }
+
+    /**
+     * @brief Add a field whose value is already valid JSON
+     *
+     * @param[in] key Field name
+     * @param[in] json Value copied verbatim
+     */
+    void AddRaw(std::string_view key, std::string_view json) {
+        AddKey(key);
+        m_out.append(json.data(), json.data() + json.size());
+    }
+
+    /**
+     * @brief Get the number of fields added since BeginObject()
+     */
+    std::uint32_t GetFieldCount(void) const { return m_fieldCount; }
+
+    /**
+     * @brief Append text escaped for a JSON string literal
+     *
+     * @param[in] text Raw text
+     * @param[out] out Buffer receiving the escaped text
+     */
+    static void AppendEscaped(std::string_view text,
+                              spdlog::memory_buf_t& out);
+
+    /** Most bytes Escape() writes for one byte of text */
+    static constexpr std::size_t k_maxEscapedBytes = 6U;
+
+    /**
+     * @brief Escape text for a JSON string literal into raw storage
+     *
+     * @param[in] text Raw text
+     * @param[out] out Storage for k_maxEscapedBytes per byte of text
+     * @return One past the last byte written
+     */
+    static char* Escape(std::string_view text, char* out);
+
+   private:
+    /* Write the separator and the quoted key */
+    void AddKey(std::string_view key) {
+        if (0U != m_fieldCount) {
+            m_out.push_back(',');
+        }
+        ++m_fieldCount;
+        m_out.push_back('"');
+        AppendEscaped(key, m_out);
+        m_out.push_back('"');
+        m_out.push_back(':');
+    }
+
+    static constexpr char k_null[] = "null";
+
+    /** Destination buffer */
+    spdlog::memory_buf_t& m_out;
+
+    /** Fields written, decides the separator */
+    std::uint32_t m_fieldCount;
+};
+
+namespace detail {
+
+/**
+ * @brief Escaping kernel
+ *
+ * @details
+ * Escapes [text, end) into out, which must hold six bytes per input byte.
+ *
+ * @return End of the written text
+ */
+using EscapeFn_t = char* (*)(const char* text, const char* end, char* out);
+
+/**
+ * @brief Escaping kernels built into the library
+ */
+struct EscapeKernels_t {
+    EscapeFn_t m_scalar; /**< One byte at a time, the reference */
+    EscapeFn_t m_sse2;   /**< 16 bytes at a time, null if not built */
+    EscapeFn_t m_avx2;   /**< 32 bytes at a time, null if not runnable */
+};
+
+/**
+ * @brief Get the escaping kernels, for comparing them with each other
+ *
+ * @return Kernels, null for those the build or processor lacks
+ */
+EscapeKernels_t GetEscapeKernels(void);
+
+} /* namespace detail */
+
+} /* namespace logger */
+} /* namespace vsn */
@@ -0,0 +1,277 @@
+/**
+ * @file kv.h
+ * @brief Typed key-value fields for structured records in VSNLogger
+ *
+ * @details
+ * A structured record is a message literal followed by key, value pairs.
+ * The pairs are encoded with their types into the payload of the record,
+ * and rendered only where the record is written: text sinks receive
+ * "message key=value ...", with strings quoted when they contain spaces,
+ * while JsonFormatter writes each pair as a JSON field whose numbers and
+ * booleans keep their type.
+ *
+ * Encoding, per record: one byte with the field count, then per field the
+ * type, the key length, the key, and the value (8 bytes for numbers, 1 for
+ * booleans, a 2-byte length and the bytes for strings). Fields that do not
+ * fit the record payload are dropped, long strings are cut.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <spdlog/common.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "vsnlogger/deferred.h"
+
+namespace vsn {
+namespace logger {
+
+/** Fields kept per structured record */
+static constexpr std::size_t k_maxKvFields = 32U;
+
+/**
+ * @brief Type of an encoded field value
+ */
+enum class E_KvType : std::uint8_t {
+    E_INT = 0U,    /**< Signed integer, stored as int64 */
+    E_UINT = 1U,   /**< Unsigned integer, stored as uint64 */
+    E_DOUBLE = 2U, /**< Floating point, stored as double */
+    E_BOOL = 3U,   /**< Boolean */
+    E_STRING = 4U  /**< Text, copied into the record */
+};
+
+/**
+ * @brief Decoded field, views into the encoded record
+ */
+struct KvField_t {
+    std::string_view m_key; /**< Field name */
+    E_KvType m_type;        /**< Selects the value member */
+    std::int64_t m_int;
+    std::uint64_t m_uint;
+    double m_double;
+    bool m_bool;
+    std::string_view m_string;
+};
+
+namespace detail {
+
+/**
+ * @brief Writer of encoded fields into a record payload
+ */
+class KvEncoder_t {
+   public:
+    /**
+     * @brief Constructor
+     *
+     * @param[out] data Payload receiving the fields
+     * @param[in] capacity Payload size, at least 1
+     */
+    KvEncoder_t(unsigned char* data, std::size_t capacity)
+        : m_data(data), m_capacity(capacity), m_size(1U) {
+        m_data[0] = 0U;
+    }
+
+    void AddInt(std::string_view key, std::int64_t value) {
+        AddFixed(key, E_KvType::E_INT, &value, sizeof(value));
+    }
+
+    void AddUint(std::string_view key, std::uint64_t value) {
+        AddFixed(key, E_KvType::E_UINT, &value, sizeof(value));
+    }
+
+    void AddDouble(std::string_view key, double value) {
+        AddFixed(key, E_KvType::E_DOUBLE, &value, sizeof(value));
+    }
+
+    void AddBool(std::string_view key, bool value) {
+        const unsigned char byte = value ? 1U : 0U;
+        AddFixed(key, E_KvType::E_BOOL, &byte, sizeof(byte));
+    }
+
+    void AddString(std::string_view key, std::string_view value) {
+        if (!Begin(key, E_KvType::E_STRING, sizeof(std::uint16_t))) {
+            return;
+        }
+        const std::uint16_t length = static_cast<std::uint16_t>(
+            std::min(value.size(), m_capacity - m_size - sizeof(length)));
+        std::memcpy(m_data + m_size, &length, sizeof(length));
+        std::memcpy(m_data + m_size + sizeof(length), value.data(), length);
+        m_size += sizeof(length) + length;
+    }
+
+    /**
+     * @brief Get the number of payload bytes used
+     */
+    std::size_t GetSize(void) const { return m_size; }
+
+   private:
+    /* Write the field header if the field fits, valueSize at least */
+    bool Begin(std::string_view key, E_KvType type, std::size_t valueSize) {
+        const std::size_t keyLength = std::min<std::size_t>(key.size(), 255U);
+        if ((m_data[0] >= k_maxKvFields) ||
+            ((m_capacity - m_size) < (2U + keyLength + valueSize))) {
+            return false;
+        }
+        m_data[m_size] = static_cast<unsigned char>(type);
+        m_data[m_size + 1U] = static_cast<unsigned char>(keyLength);
+        std::memcpy(m_data + m_size + 2U, key.data(), keyLength);
+        m_size += 2U + keyLength;
+        ++m_data[0];
+        return true;
+    }
+
+    void AddFixed(std::string_view key, E_KvType type, const void* value,
+                  std::size_t size) {
+        if (Begin(key, type, size)) {
+            std::memcpy(m_data + m_size, value, size);
+            m_size += size;
+        }
+    }
+
+    unsigned char* const m_data;
+    const std::size_t m_capacity;
+    std::size_t m_size;
+};
+
+/**
+ * @brief Encode one value with the field type matching its C++ type
+ */
+template <typename T>
+void EncodeKvValue(KvEncoder_t& encoder, std::string_view key,
+                   const T& value) {
+    if constexpr (std::is_same<T, bool>::value) {
+        encoder.AddBool(key, value);
+    } else if constexpr (std::is_same<T, char>::value) {
+        encoder.AddString(key, std::string_view(&value, 1U));
+    } else if constexpr (std::is_enum<T>::value) {
+        EncodeKvValue(encoder, key,
+                      static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_integral<T>::value &&
+                         std::is_signed<T>::value) {
+        encoder.AddInt(key, static_cast<std::int64_t>(value));
+    } else if constexpr (std::is_integral<T>::value) {
+        encoder.AddUint(key, static_cast<std::uint64_t>(value));
+    } else if constexpr (std::is_floating_point<T>::value) {
+        encoder.AddDouble(key, static_cast<double>(value));
+    } else if constexpr (std::is_convertible<const T&, const char*>::value) {
+        const char* const text = value;
+        encoder.AddString(key, (nullptr != text) ? std::string_view(text)
+                                                 : std::string_view("(null)"));
+    } else {
+        static_assert(std::is_convertible<const T&, std::string_view>::value,
+                      "Key-value fields take integers, floating point, bool, "
+                      "enums and strings");
+        encoder.AddString(key, std::string_view(value));
+    }
+}
+
+/**
+ * @brief Encode key, value pairs
+ */
+inline void EncodeKv(KvEncoder_t& /* encoder */) {}
+
+template <typename Key, typename Value, typename... Rest>
+void EncodeKv(KvEncoder_t& encoder, const Key& key, const Value& value,
+              const Rest&... rest) {
+    static_assert(std::is_convertible<const Key&, std::string_view>::value,
+                  "Key-value field names must be strings");
+    EncodeKvValue(encoder, std::string_view(key), value);
+    EncodeKv(encoder, rest...);
+}
+
+/**
+ * @brief Reader of encoded fields
+ */
+class KvReader_t {
+   public:
+    explicit KvReader_t(const unsigned char* data)
+        : m_data(data), m_offset(1U), m_remaining(data[0]) {}
+
+    /**
+     * @brief Decode the next field
+     *
+     * @param[out] field Decoded field
+     * @return false after the last field
+     */
+    bool Next(KvField_t& field);
+
+   private:
+    const unsigned char* const m_data;
+    std::size_t m_offset;
+    std::uint32_t m_remaining;
+};
+
+/**
+ * @brief Render a structured record as text: message, then " key=value"
+ *
+ * @details
+ * Decoder of structured records, see async::DecodeFn_t.
+ *
+ * @param[in] message Message literal
+ * @param[in] data Encoded fields
+ * @param[out] out Buffer receiving the text
+ */
+void DecodeKv(const char* message, const unsigned char* data,
+              spdlog::memory_buf_t& out);
+
+/**
+ * @brief Fields of the record being written on the calling thread
+ */
+struct KvContext_t {
+    const char* m_text;            /**< Rendered payload of the record */
+    std::size_t m_messageLength;   /**< Payload bytes before the fields */
+    const unsigned char* m_fields; /**< Encoded fields */
+};
+
+/**
+ * @brief Context of the record being written, null outside structured ones
+ */
+extern thread_local const KvContext_t* t_kvContext;
+
+/**
+ * @brief Describe a record about to be written
+ *
+ * @param[in] record Record, structured or not
+ * @param[in] text Rendered payload handed to the sinks
+ * @param[out] context Storage for the context
+ * @return context for a structured record, else null
+ */
+const KvContext_t* BindKvContext(const async::AsyncRecord_t& record,
+                                 const char* text, KvContext_t& context);
+
+/**
+ * @brief Fields of a record, as seen by a formatter
+ *
+ * @param[in] text Payload of the message being formatted
+ * @return Context of the record, null if it carries no fields
+ */
+inline const KvContext_t* CurrentKvContext(const char* text) {
+    const KvContext_t* const context = t_kvContext;
+    return ((nullptr != context) && (context->m_text == text)) ? context
+                                                               : nullptr;
+}
+
+/**
+ * @brief Publish a context while a record goes to the sinks
+ */
+class KvScope_t {
+   public:
+    explicit KvScope_t(const KvContext_t* context) { t_kvContext = context; }
+    ~KvScope_t(void) { t_kvContext = nullptr; }
+
+    KvScope_t(const KvScope_t&) = delete;
+    KvScope_t& operator=(const KvScope_t&) = delete;
+};
+
+} /* namespace detail */
+} /* namespace logger */
+} /* namespace vsn */
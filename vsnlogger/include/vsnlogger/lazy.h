@@ -0,0 +1,67 @@
+/**
+ * @file lazy.h
+ * @brief Lazily evaluated logging arguments for VSNLogger
+ *
+ * @details
+ * A closure passed as a logging argument, e.g. [&] { return Dump(cfg); },
+ * is invoked only after the level checks pass and its result is formatted
+ * in its place. Expensive diagnostics therefore cost nothing when their
+ * level is disabled, including through the Logger::Debug(loc, ...) style
+ * functions, which receive their arguments already evaluated. The flight
+ * recorder does not capture calls with a lazy argument, so a closure never
+ * runs for a disabled level.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <type_traits>
+
+namespace vsn {
+namespace logger {
+namespace detail {
+
+/**
+ * @brief Argument types invoked before formatting
+ *
+ * @details
+ * Class types callable without arguments and returning a value: lambdas,
+ * std::function and other function objects. Function pointers are left
+ * alone.
+ */
+template <typename T, typename Enable = void>
+struct IsLazyArg : std::false_type {};
+
+template <typename T>
+struct IsLazyArg<T, typename std::enable_if<
+                        std::is_class<T>::value &&
+                        std::is_invocable<const T&>::value>::type>
+    : std::integral_constant<
+          bool, !std::is_void<std::invoke_result_t<const T&>>::value> {};
+
+/**
+ * @brief True if any argument is lazy
+ */
+template <typename... Args>
+struct HasLazyArg : std::disjunction<IsLazyArg<Args>...> {};
+
+/**
+ * @brief Value to format for an argument
+ *
+ * @param[in] arg Logging argument
+ * @return Result of a lazy argument, the argument itself otherwise
+ */
+template <typename T>
+decltype(auto) ResolveArg(const T& arg) {
+    if constexpr (IsLazyArg<T>::value) {
+        return arg();
+    } else {
+        return (arg);
+    }
+}
+
+} /* namespace detail */
+} /* namespace logger */
+} /* namespace vsn */
@@ -17,12 +17,13 @@
  *
  * @limitations
  * - Limited to 8 concurrent output destinations
- * - Maximum 256 character message length
+ * - Messages truncated at 256 characters unless configured otherwise
  * - Non-reentrant from interrupt contexts
  */
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -37,11 +38,22 @@ enum level_enum : int;
 }
 struct source_loc;
 class logger;
+namespace sinks {
+class sink;
+}
 }
 
 namespace vsn {
 namespace logger {
 
+/* Forward declaration of asynchronous backend types */
+namespace async {
+class AsyncBackend;
+struct AsyncOptions_t;
+struct AsyncRecord_t;
+struct AsyncStats_t;
+}  // namespace async
+
 /**
  * @brief Logging severity levels
  */
@@ -64,6 +76,15 @@ struct SourceLocation_t {
     const char* const m_function;
 };
 
+/* Static call-site descriptor, defined in site.h */
+struct LogSite_t;
+
+/* Interned component handle, defined in component.h */
+struct Component_t;
+
+/* Ring of records below the active level, defined in recorder.h */
+class FlightRecorder;
+
 /**
  * @brief Core logger class that wraps spdlog functionality with MISRA compliant
  * interface
@@ -106,16 +127,46 @@ class Logger {
     static E_Result Initialize(const std::string& appName,
                                const std::string& logDir, E_LogLevel level);
 
+    /**
+     * @brief Initialize the default global logger with explicit async mode
+     *
+     * @details
+     * The three-argument overload reads the same settings from the
+     * application section of the configuration (async, queue_size,
+     * worker_threads, overflow_policy, overflow_level).
+     *
+     * @param[in] appName Application identifier
+     * @param[in] logDir Directory for log file storage
+     * @param[in] level Minimum severity level to log
+     * @param[in] asyncOptions Asynchronous mode settings
+     * @return Operation result code
+     */
+    static E_Result Initialize(const std::string& appName,
+                               const std::string& logDir, E_LogLevel level,
+                               const async::AsyncOptions_t& asyncOptions);
+
     /**
      * @brief Get the default logger instance
      *
-     * @return Reference to default logger
+     * @details
+     * Lock-free after the first call on each thread: the thread remembers
+     * the published handle and only takes the mutex again when Initialize()
+     * or Shutdown() publishes a new instance. As with the mutex-guarded
+     * access, the reference must not be used across a Shutdown() or
+     * re-initialization on another thread.
+     *
+     * @return Reference to the published handle to the default logger
      */
     static std::shared_ptr<Logger>& GetDefaultLogger(void);
 
     /**
      * @brief Set global log pattern from predefined formats
      *
+     * @details
+     * Applies to every output without a pattern of its own in a
+     * [sink.<name>] configuration section; syslog keeps its minimal
+     * default.
+     *
      * @param[in] patternName Name of pattern template
      * @return Operation result code
      */
@@ -129,6 +180,22 @@ class Logger {
      */
     static E_Result SetLevel(E_LogLevel level);
 
+    /**
+     * @brief Set the level of a component and the components below it
+     *
+     * @details
+     * Overrides the global level in both directions, so a component can be
+     * traced while the rest of the process logs warnings only. Names are
+     * hierarchical: a level for "net" applies to "net.http.client" unless
+     * a more specific name is configured.
+     *
+     * @param[in] component Component name
+     * @param[in] level Minimum severity level to log for the component
+     * @return Operation result code
+     */
+    static E_Result SetComponentLevel(const std::string& component,
+                                      E_LogLevel level);
+
     /**
      * @brief Initialize logging with configuration from file
      *
@@ -139,6 +206,47 @@ class Logger {
     static E_Result InitializeWithConfig(const std::string& appName,
                                          const std::string& configFile);
 
+    /**
+     * @brief Check a level against the floor of the default logger
+     *
+     * @details
+     * One relaxed atomic load. The floor is the lowest level the default
+     * logger emits or records, so the macros reject a level below it
+     * without looking the default logger up; a level at or above it still
+     * goes through ShouldLog().
+     *
+     * @param[in] level Severity level to test
+     * @return false if the default logger takes no record of this level
+     */
+    static bool PassesLevelFloor(E_LogLevel level);
+
+    /**
+     * @brief Check whether a record of the given level would be logged
+     *
+     * @details
+     * Two relaxed atomic loads (backend level and level table), plus one
+     * for the flight recorder when the level is disabled, intended for
+     * macros to test before any argument expression is evaluated.
+     *
+     * @param[in] level Severity level to test
+     * @return true if the level is enabled on this logger
+     */
+    bool ShouldLog(E_LogLevel level) const;
+
+    /**
+     * @brief Check whether a component's record of the given level would be
+     * logged
+     *
+     * @details
+     * Looks the component up in the level table by its interned ID, so the
+     * cost does not depend on the number of components or rules.
+     *
+     * @param[in] level Severity level to test
+     * @param[in] component Component of the record, null for none
+     * @return true if the level is enabled for the component
+     */
+    bool ShouldLog(E_LogLevel level, Component_t* component) const;
+
     /**
      * @brief Log with specified level and source location
      *
@@ -151,6 +259,47 @@ class Logger {
     E_Result LogWithLocation(SourceLocation_t loc, E_LogLevel level,
                              const char* fmt, const Args&... args);
 
+    /**
+     * @brief Log through a static call-site descriptor
+     *
+     * @details
+     * Used by the VSN_* macros. Location, level and format length come from
+     * the descriptor, and the format was parsed and checked against the
+     * argument types at compile time, so no string work is done per call.
+     *
+     * @param[in] site Descriptor of the calling statement
+     * @param[in] component Component of the statement, null for none
+     * @param[in] suppressed Calls suppressed by the site's rate limit since
+     *            its previous record, reported at the end of the message
+     * @param[in] format Compiled format (FMT_COMPILE) of the site
+     * @param[in] fmt Format string of the site, kept for deferred records
+     * @return Operation result code
+     */
+    template <typename Format, typename... Args>
+    E_Result Log(const LogSite_t& site, Component_t* component,
+                 std::uint64_t suppressed, const Format& format,
+                 const char* fmt, const Args&... args);
+
+    /**
+     * @brief Log a structured record through a static call-site descriptor
+     *
+     * @details
+     * Used by the VSN_<LEVEL>_KV macros. The fields keep their types until a
+     * sink writes the record: text sinks get "message key=value ...", the
+     * JSON formatter typed JSON fields. Records below the active level are
+     * not kept by the flight recorder.
+     *
+     * @param[in] site Descriptor of the calling statement
+     * @param[in] component Component of the statement, null for none
+     * @param[in] message Message literal, must outlive the record
+     * @param[in] args Key, value pairs: string keys; integer, floating
+     *            point, bool, enum or string values
+     * @return Operation result code
+     */
+    template <typename... Args>
+    E_Result LogKv(const LogSite_t& site, Component_t* component,
+                   const char* message, const Args&... args);
+
     /**
      * @brief Trace level logging
      *
@@ -212,6 +361,80 @@ class Logger {
     E_Result Critical(SourceLocation_t loc, const char* fmt,
                       const Args&... args);
 
+    /**
+     * @brief Reserve the calling thread's logging resources
+     *
+     * @details
+     * After Initialize() the built-in console, file and null sinks log
+     * without heap allocation. The remaining per-thread state (the staging
+     * buffers and, in per-thread async mode, the thread's ring) is set up by
+     * a thread's first log call; calling this at thread start moves that
+     * cost out of the logging path.
+     *
+     * @return Operation result code
+     */
+    E_Result PrepareThread(void);
+
+    /**
+     * @brief Set the maximum length of a formatted message
+     *
+     * @details
+     * Messages are rendered into a fixed per-thread buffer; longer output
+     * is cut and ends with k_truncationMarker. Defaults to 256 characters.
+     *
+     * @param[in] length Limit in bytes, above the marker length and at most
+     *            k_maxMessageBuffer
+     * @return Operation result code
+     */
+    E_Result SetMaxMessageLength(std::uint32_t length);
+
+    /**
+     * @brief Get the maximum length of a formatted message
+     *
+     * @return Limit in bytes
+     */
+    std::uint32_t GetMaxMessageLength(void) const;
+
+    /**
+     * @brief Keep recent records below the active level in memory
+     *
+     * @details
+     * Records from level up to the active level are captured into a fixed
+     * ring of capacity records instead of being written. A record at or
+     * above trigger writes the records captured since the last dump to
+     * the sinks, oldest first, ahead of itself. The ring is allocated on
+     * the first call; later calls may change the levels but not the
+     * capacity.
+     *
+     * @param[in] capacity Number of records kept, 1 to
+     *            FlightRecorder::k_maxCapacity
+     * @param[in] level Lowest level captured
+     * @param[in] trigger Lowest level that writes the ring out
+     * @return Operation result code, E_INVALID_STATE if the capacity differs
+     *         from an earlier call
+     */
+    E_Result EnableFlightRecorder(std::uint32_t capacity, E_LogLevel level,
+                                  E_LogLevel trigger);
+
+    /**
+     * @brief Stop capturing records below the active level
+     *
+     * @details
+     * Records already captured are kept and still written by
+     * DumpFlightRecorder().
+     *
+     * @return Operation result code
+     */
+    E_Result DisableFlightRecorder(void);
+
+    /**
+     * @brief Write the records captured since the last dump to the sinks
+     *
+     * @return Operation result code, E_INVALID_STATE if the flight recorder
+     *         was never enabled
+     */
+    E_Result DumpFlightRecorder(void);
+
     /**
      * @brief Get the underlying spdlog logger
      *
@@ -226,6 +449,14 @@ class Logger {
      */
     E_Result Flush(void);
 
+    /**
+     * @brief Get queue and drop counters of the asynchronous backend
+     *
+     * @param[out] stats Counter snapshot
+     * @return Operation result code, E_INVALID_STATE if logging synchronously
+     */
+    E_Result GetAsyncStats(async::AsyncStats_t& stats) const;
+
     /**
      * @brief Shutdown all loggers
      *
@@ -234,20 +465,130 @@ class Logger {
     static E_Result Shutdown(void);
 
    private:
+    /**
+     * @brief Check whether a record is written, ignoring the flight recorder
+     *
+     * @param[in] level Severity level to test
+     * @param[in] component Component of the record, null for none
+     * @return true if the level is enabled for the component
+     */
+    bool IsEnabled(E_LogLevel level, Component_t* component) const;
+
+    /**
+     * @brief Check levels for a validated record and resolve lazy arguments
+     *
+     * @param[in] loc Source location reported with the record
+     * @param[in] level Severity level for message
+     * @param[in] component Component prefixed to the message, null for none
+     * @param[in] suppressed Suppressed record count appended, 0 for none
+     * @param[in] format Compiled format, or RuntimeFormat_t to parse fmt
+     * @param[in] fmt Format string (must be valid for lifetime of call)
+     * @return Operation result code
+     */
+    template <typename Format, typename... Args>
+    E_Result Write(const spdlog::source_loc& loc, E_LogLevel level,
+                   Component_t* component, std::uint64_t suppressed,
+                   const Format& format, const char* fmt,
+                   const Args&... args);
+
+    /**
+     * @brief Format and emit an enabled record with resolved arguments
+     *
+     * @param[in] loc Source location reported with the record
+     * @param[in] level Severity level for message
+     * @param[in] component Component prefixed to the message, null for none
+     * @param[in] suppressed Suppressed record count appended, 0 for none
+     * @param[in] format Compiled format, or RuntimeFormat_t to parse fmt
+     * @param[in] fmt Format string (must be valid for lifetime of call)
+     * @return Operation result code
+     */
+    template <typename Format, typename... Args>
+    E_Result Emit(const spdlog::source_loc& loc, E_LogLevel level,
+                  Component_t* component, std::uint64_t suppressed,
+                  const Format& format, const char* fmt, const Args&... args);
+
+    /**
+     * @brief Hand a deferred record to the asynchronous backend
+     *
+     * @param[in] record Record staged by the calling thread
+     * @return Operation result code
+     */
+    E_Result EnqueueDeferred(const async::AsyncRecord_t& record);
+
+    /**
+     * @brief Write a structured record, or queue it in asynchronous mode
+     *
+     * @param[in] record Record staged by the calling thread
+     * @return Operation result code
+     */
+    E_Result EmitKv(const async::AsyncRecord_t& record);
+
+    /**
+     * @brief Refresh the calling thread's default logger handle
+     *
+     * @details
+     * Slow path of GetDefaultLogger(), taken on first use and after the
+     * default instance changed.
+     *
+     * @return Reference to the published handle
+     */
+    static std::shared_ptr<Logger>& RefreshDefaultLogger(void);
+
+    /**
+     * @brief Recompute the level floor from the default instance
+     *
+     * @details
+     * Takes the lowest component level and the default instance's
+     * recorder level; without a default instance every level passes.
+     * The caller holds the singleton mutex.
+     */
+    static void PublishLevelFloor(void);
+
+    /**
+     * @brief Lower the level floor, never raising it
+     *
+     * @param[in] level Level that must pass the floor
+     */
+    static void LowerLevelFloor(std::uint8_t level);
+
     /** Maximum number of sinks allowed per logger instance */
     static constexpr std::uint8_t k_maxSinks = 8U;
 
     /** Maximum message length in characters */
     static constexpr std::uint16_t k_maxMessageLength = 256U;
 
+    /** Recorder level above every E_LogLevel, so no record is captured */
+    static constexpr std::uint8_t k_recorderDisabled = 0xFFU;
+
     /** Underlying spdlog logger instance */
     std::shared_ptr<spdlog::logger> m_logger;
 
+    /** Asynchronous backend, null when logging synchronously */
+    std::shared_ptr<async::AsyncBackend> m_asyncBackend;
+
+    /** Capture raw arguments and let the backend format them */
+    bool m_deferredFormatting;
+
+    /** Formatted messages are truncated to this many bytes */
+    std::atomic<std::uint32_t> m_maxMessageLength;
+
+    /** Flight recorder, allocated once by EnableFlightRecorder() */
+    std::unique_ptr<FlightRecorder> m_recorder;
+
+    /** Lowest level captured by m_recorder, k_recorderDisabled if none */
+    std::atomic<std::uint8_t> m_recordLevel;
+
+    /** Lowest level that writes m_recorder out, k_recorderDisabled if none */
+    std::atomic<std::uint8_t> m_dumpLevel;
+
     /** Default logger instance for global access */
     static std::shared_ptr<Logger> ms_defaultInstance;
 
     /** Allocation counter for resource tracking */
     static std::uint32_t ms_allocationCount;
+
+    /** Lowest level the default instance emits or records */
+    static std::atomic<std::uint8_t> ms_levelFloor;
 };
 
 } /* namespace logger */
@@ -8,9 +8,45 @@
 // Include full spdlog definitions needed for template implementations
 #include <spdlog/spdlog.h>
 
+#include "vsnlogger/clock.h"
+#include "vsnlogger/component.h"
+#include "vsnlogger/deferred.h"
+#include "vsnlogger/format.h"
+#include "vsnlogger/kv.h"
+#include "vsnlogger/lazy.h"
+#include "vsnlogger/recorder.h"
+#include "vsnlogger/site.h"
+
 namespace vsn {
 namespace logger {
 
+inline bool Logger::PassesLevelFloor(E_LogLevel level) {
+    return static_cast<std::uint8_t>(level) >=
+           ms_levelFloor.load(std::memory_order_relaxed);
+}
+
+inline bool Logger::ShouldLog(E_LogLevel level) const {
+    return ShouldLog(level, nullptr);
+}
+
+inline bool Logger::ShouldLog(E_LogLevel level, Component_t* component) const {
+    return IsEnabled(level, component) ||
+           (static_cast<std::uint8_t>(level) >=
+            m_recordLevel.load(std::memory_order_relaxed));
+}
+
+inline bool Logger::IsEnabled(E_LogLevel level, Component_t* component) const {
+    /* The backend level is the lowest level of any component */
+    if (!m_logger ||
+        !m_logger->should_log(static_cast<spdlog::level::level_enum>(level))) {
+        return false;
+    }
+
+    const std::uint32_t id =
+        (nullptr != component) ? component->GetId() : k_defaultComponent;
+    return IsComponentLevelEnabled(id, level);
+}
+
 /* Template method implementations */
 template <typename... Args>
 E_Result Logger::LogWithLocation(SourceLocation_t loc, E_LogLevel level,
@@ -32,14 +68,158 @@ E_Result Logger::LogWithLocation(SourceLocation_t loc, E_LogLevel level,
         }
 
         /* Convert to spdlog source location */
-        spdlog::source_loc spdlogLoc{
+        const spdlog::source_loc spdlogLoc{
             loc.m_filename, static_cast<int>(loc.m_line), loc.m_function};
 
-        /* Log message with level */
-        m_logger->log(spdlogLoc, static_cast<spdlog::level::level_enum>(level),
-                      fmt, args...);
+        return Write(spdlogLoc, level, nullptr, 0U,
+                     detail::RuntimeFormat_t(), fmt, args...);
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
 
+template <typename Format, typename... Args>
+E_Result Logger::Log(const LogSite_t& site, Component_t* component,
+                     std::uint64_t suppressed, const Format& format,
+                     const char* fmt, const Args&... args) {
+    static_assert(k_maxFormatLength == Logger::k_maxMessageLength,
+                  "Site format limit must match the logger limit");
+
+    try {
+        if (!m_logger) {
+            return E_Result::E_NOT_INITIALIZED;
+        }
+
+        /* Format length was checked when the site was compiled */
+        const spdlog::source_loc spdlogLoc{
+            site.m_filename, static_cast<int>(site.m_line), site.m_function};
+
+        return Write(spdlogLoc, site.m_level, component, suppressed, format,
+                     fmt, args...);
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+template <typename Format, typename... Args>
+E_Result Logger::Write(const spdlog::source_loc& loc, E_LogLevel level,
+                       Component_t* component, std::uint64_t suppressed,
+                       const Format& format, const char* fmt,
+                       const Args&... args) {
+    if (!IsEnabled(level, component)) {
+        /* Below the active level: keep it in the flight recorder only,
+         * unless that would run a lazy argument */
+        if constexpr (!detail::HasLazyArg<Args...>::value) {
+            if (static_cast<std::uint8_t>(level) >=
+                m_recordLevel.load(std::memory_order_acquire)) {
+                m_recorder->Capture(
+                    m_maxMessageLength.load(std::memory_order_relaxed), loc,
+                    level, component, suppressed, format, fmt, args...);
+            }
+        }
         return E_Result::E_SUCCESS;
+    }
+
+    if (nullptr != component) {
+        CountComponentRecord(component->GetId(), level);
+    }
+
+    /* Context captured before a failure goes out ahead of it; one compare
+     * here, the dump itself is out of line */
+    if (static_cast<std::uint8_t>(level) >=
+        m_dumpLevel.load(std::memory_order_relaxed)) {
+        static_cast<void>(DumpFlightRecorder());
+    }
+
+    /* Lazy arguments run only now that the record is known to be wanted */
+    return Emit(loc, level, component, suppressed, format, fmt,
+                detail::ResolveArg(args)...);
+}
+
+template <typename Format, typename... Args>
+E_Result Logger::Emit(const spdlog::source_loc& loc, E_LogLevel level,
+                      Component_t* component, std::uint64_t suppressed,
+                      const Format& format, const char* fmt,
+                      const Args&... args) {
+    const auto spdlogLevel = static_cast<spdlog::level::level_enum>(level);
+
+    /* Deferred mode: copy raw arguments, the writer thread formats */
+    if constexpr (async::detail::IsDeferrable<Args...>::value) {
+        if (m_deferredFormatting) {
+            async::AsyncRecord_t& record = async::detail::StagingRecord();
+            if (async::detail::EncodeArgs<Format>(record, fmt, args...)) {
+                record.m_ticks = detail::ClockTicks();
+                record.m_source = loc;
+                record.m_threadId = async::detail::ThreadId();
+                record.m_level = spdlogLevel;
+                record.m_component = component;
+                record.m_suppressed = suppressed;
+                return EnqueueDeferred(record);
+            }
+            /* Arguments too large to capture: format eagerly below */
+        }
+    }
+
+    /* Render into the thread's fixed buffer, spdlog only copies the text */
+    const std::size_t limit =
+        m_maxMessageLength.load(std::memory_order_relaxed);
+    spdlog::string_view_t message = detail::FormatBounded(
+        limit, (nullptr != component) ? component->m_prefix : nullptr,
+        (nullptr != component) ? component->m_prefixLength : 0U, format, fmt,
+        args...);
+    if (suppressed > 0U) {
+        char* const buffer = detail::MessageBuffer();
+        message = spdlog::string_view_t(
+            buffer, detail::AppendSuppressed(buffer, message.size(), limit,
+                                             suppressed));
+    }
+    m_logger->log(detail::ClockNow(), loc, spdlogLevel, message);
+
+    return E_Result::E_SUCCESS;
+}
+
+template <typename... Args>
+E_Result Logger::LogKv(const LogSite_t& site, Component_t* component,
+                       const char* message, const Args&... args) {
+    static_assert((sizeof...(Args) % 2U) == 0U,
+                  "Key-value fields come as key, value pairs");
+
+    try {
+        if (!m_logger) {
+            return E_Result::E_NOT_INITIALIZED;
+        }
+        /* Below the active level the record only goes to the recorder */
+        const bool enabled = IsEnabled(site.m_level, component);
+        if (!enabled && (static_cast<std::uint8_t>(site.m_level) <
+                         m_recordLevel.load(std::memory_order_acquire))) {
+            return E_Result::E_SUCCESS;
+        }
+
+        /* Fields are encoded typed, sinks render them */
+        async::AsyncRecord_t& record = async::detail::StagingRecord();
+        detail::KvEncoder_t encoder(record.m_payload,
+                                    async::k_maxRecordPayload);
+        detail::EncodeKv(encoder, args...);
+
+        record.m_ticks = detail::ClockTicks();
+        record.m_source = spdlog::source_loc{
+            site.m_filename, static_cast<int>(site.m_line), site.m_function};
+        record.m_threadId = async::detail::ThreadId();
+        record.m_level = static_cast<spdlog::level::level_enum>(site.m_level);
+        record.m_component = component;
+        record.m_suppressed = 0U;
+        record.m_decode = &detail::DecodeKv;
+        record.m_format = message;
+        record.m_size = static_cast<std::uint16_t>(encoder.GetSize());
+        if (!enabled) {
+            m_recorder->Store(record);
+            return E_Result::E_SUCCESS;
+        }
+
+        if (nullptr != component) {
+            CountComponentRecord(component->GetId(), site.m_level);
+        }
+        return EmitKv(record);
     } catch (...) {
         return E_Result::E_UNKNOWN_ERROR;
     }
@@ -12,10 +12,16 @@
 
 #pragma once
 
-#include <spdlog/fmt/chrono.h> /* For chrono types */
+#include <spdlog/fmt/chrono.h>  /* For chrono types */
+#include <spdlog/fmt/compile.h> /* For FMT_COMPILE */
 #include <spdlog/fmt/ostr.h>   /* For custom types with operator */
 
+#include "component.h"
 #include "logger.h"
+#include "ratelimit.h"
+#include "kv.h"
+#include "site.h"
+#include "timer.h"
 
 /**
  * @brief Extract filename from full path at compile time
@@ -43,54 +49,551 @@
         VSN_FILENAME, static_cast<std::uint32_t>(__LINE__), __func__ \
     }
 
+/**
+ * @brief Numeric severity values for compile-time filtering
+ *
+ * @details
+ * Values match E_LogLevel so they can be compared against VSN_ACTIVE_LEVEL in
+ * preprocessor conditionals.
+ */
+#define VSN_LEVEL_TRACE 0
+#define VSN_LEVEL_DEBUG 1
+#define VSN_LEVEL_INFO 2
+#define VSN_LEVEL_WARN 3
+#define VSN_LEVEL_ERROR 4
+#define VSN_LEVEL_CRITICAL 5
+#define VSN_LEVEL_OFF 6
+
+/**
+ * @brief Compile-time severity threshold
+ *
+ * @details
+ * Statements below this level expand to a constant and neither the logger
+ * call nor any argument expression is compiled in. Set through the
+ * VSN_ACTIVE_LEVEL CMake cache variable or defined before including this
+ * header.
+ */
+#ifndef VSN_ACTIVE_LEVEL
+#define VSN_ACTIVE_LEVEL VSN_LEVEL_TRACE
+#endif
+
+/**
+ * @brief Statement removed at compile time
+ */
+#define VSN_LOG_DISABLED \
+    do {                 \
+    } while (false)
+
+/**
+ * @brief First argument of a variadic list (call with a trailing filler)
+ */
+#define VSN_FIRST_ARG(first, ...) first
+
+/**
+ * @brief Dispatch to the default logger after the runtime level check
+ *
+ * @details
+ * Each expansion owns a constant-initialized LogSite_t, so location, level
+ * and format are fixed at compile time. The format string must be a
+ * string literal; it is compiled with FMT_COMPILE, so a placeholder that
+ * does not match the arguments is a build error and the format is never
+ * parsed at run time. Arguments are only evaluated when the level is
+ * enabled on the default logger and in the level table entry of the
+ * component, and admit holds. A level below the floor of the default
+ * logger is rejected first with one relaxed atomic load, before the
+ * default logger is looked up. componentPtr is null or points to a static
+ * Component_t whose prefix is copied ahead of the message. admit may set
+ * vsnSuppressed to the number of calls it rejected before this one.
+ */
+#define VSN_LOG_SITE_IF(level, componentPtr, admit, ...)                     \
+    do {                                                                     \
+        static_assert(::vsn::logger::FormatLength(                           \
+                          VSN_FIRST_ARG(__VA_ARGS__, 0)) <=                  \
+                          ::vsn::logger::k_maxFormatLength,                  \
+                      "Log format string too long");                         \
+        static ::vsn::logger::LogSite_t vsnLogSite(                          \
+            __FILE__, static_cast<std::uint32_t>(__LINE__), __func__, level, \
+            VSN_FIRST_ARG(__VA_ARGS__, 0));                                  \
+        if (::vsn::logger::Logger::PassesLevelFloor(level)) {                \
+            ::vsn::logger::Logger& vsnLogger =                               \
+                *::vsn::logger::Logger::GetDefaultLogger();                  \
+            std::uint64_t vsnSuppressed = 0U;                                \
+            if (vsnLogger.ShouldLog(level, componentPtr) && (admit)) {       \
+                ::vsn::logger::TouchLogSite(vsnLogSite);                     \
+                static_cast<void>(vsnLogger.Log(                             \
+                    vsnLogSite, componentPtr, vsnSuppressed,                 \
+                    FMT_COMPILE(VSN_FIRST_ARG(__VA_ARGS__, 0)),              \
+                    __VA_ARGS__));                                           \
+            }                                                                \
+        }                                                                    \
+    } while (false)
+
+/**
+ * @brief Statement emitted whenever its level is enabled
+ */
+#define VSN_LOG_SITE(level, componentPtr, ...) \
+    VSN_LOG_SITE_IF(level, componentPtr, true, __VA_ARGS__)
+
+/**
+ * @brief Statement admitted by a rate-limit policy of ratelimit.h
+ *
+ * @details
+ * The policy runs only when the level is enabled and before any argument
+ * is evaluated, so a suppressed call is never formatted.
+ */
+#define VSN_LOG_LIMITED(level, componentPtr, policy, param, ...)             \
+    do {                                                                     \
+        static ::vsn::logger::RateLimit_t vsnRateLimit;                      \
+        VSN_LOG_SITE_IF(level, componentPtr,                                 \
+                        ::vsn::logger::policy(                               \
+                            vsnRateLimit, static_cast<std::uint64_t>(param), \
+                            vsnSuppressed),                                  \
+                        __VA_ARGS__);                                        \
+    } while (false)
+
+/**
+ * @brief Statement without a component
+ */
+#define VSN_LOG_ENABLED(level, ...) VSN_LOG_SITE(level, nullptr, __VA_ARGS__)
+
+/**
+ * @brief Statement tagged with a component
+ *
+ * @details
+ * component is a handle declared with VSN_DECLARE_COMPONENT or a string
+ * literal. Either way the reference is constant-initialized, so the prefix
+ * is rendered at compile time and the component is interned on first use.
+ */
+#define VSN_LOG_COMPONENT_ENABLED(level, component, ...)                 \
+    do {                                                                 \
+        static ::vsn::logger::ComponentRef_t vsnComponentRef(component); \
+        VSN_LOG_SITE(level, &vsnComponentRef.Get(), __VA_ARGS__);        \
+    } while (false)
+
+/**
+ * @brief Rate-limited statement tagged with a component
+ */
+#define VSN_LOG_COMPONENT_LIMITED(level, component, policy, param, ...)  \
+    do {                                                                 \
+        static ::vsn::logger::ComponentRef_t vsnComponentRef(component); \
+        VSN_LOG_LIMITED(level, &vsnComponentRef.Get(), policy, param,    \
+                        __VA_ARGS__);                                    \
+    } while (false)
+
 /**
  * @brief Basic logging macros with source location information
  */
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_TRACE
 #define VSN_TRACE(...) \
-    ::vsn::logger::Logger::GetDefaultLogger()->Trace(VSN_SRC_LOC, __VA_ARGS__)
+    VSN_LOG_ENABLED(::vsn::logger::E_LogLevel::E_TRACE, __VA_ARGS__)
+#else
+#define VSN_TRACE(...) VSN_LOG_DISABLED
+#endif
 
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_DEBUG
 #define VSN_DEBUG(...) \
-    ::vsn::logger::Logger::GetDefaultLogger()->Debug(VSN_SRC_LOC, __VA_ARGS__)
+    VSN_LOG_ENABLED(::vsn::logger::E_LogLevel::E_DEBUG, __VA_ARGS__)
+#else
+#define VSN_DEBUG(...) VSN_LOG_DISABLED
+#endif
 
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_INFO
 #define VSN_INFO(...) \
-    ::vsn::logger::Logger::GetDefaultLogger()->Info(VSN_SRC_LOC, __VA_ARGS__)
+    VSN_LOG_ENABLED(::vsn::logger::E_LogLevel::E_INFO, __VA_ARGS__)
+#else
+#define VSN_INFO(...) VSN_LOG_DISABLED
+#endif
 
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_WARN
 #define VSN_WARN(...) \
-    ::vsn::logger::Logger::GetDefaultLogger()->Warn(VSN_SRC_LOC, __VA_ARGS__)
+    VSN_LOG_ENABLED(::vsn::logger::E_LogLevel::E_WARN, __VA_ARGS__)
+#else
+#define VSN_WARN(...) VSN_LOG_DISABLED
+#endif
 
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_ERROR
 #define VSN_ERROR(...) \
-    ::vsn::logger::Logger::GetDefaultLogger()->Error(VSN_SRC_LOC, __VA_ARGS__)
+    VSN_LOG_ENABLED(::vsn::logger::E_LogLevel::E_ERROR, __VA_ARGS__)
+#else
+#define VSN_ERROR(...) VSN_LOG_DISABLED
+#endif
 
-#define VSN_CRITICAL(...)                                            \
-    ::vsn::logger::Logger::GetDefaultLogger()->Critical(VSN_SRC_LOC, \
-                                                        __VA_ARGS__)
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_CRITICAL
+#define VSN_CRITICAL(...) \
+    VSN_LOG_ENABLED(::vsn::logger::E_LogLevel::E_CRITICAL, __VA_ARGS__)
+#else
+#define VSN_CRITICAL(...) VSN_LOG_DISABLED
+#endif
 
 /**
- * @brief Component-specific logging macros (adds component name)
+ * @brief Logging macros for lazily evaluated diagnostics
+ *
+ * @details
+ * Same as VSN_<LEVEL>, named for call sites whose arguments are closures:
+ * VSN_DEBUG_LAZY("Config: {}", [&] { return DumpConfig(); }) invokes the
+ * closure only when the record is emitted. Every logging macro and the
+ * Logger level functions accept closure arguments the same way.
  */
-#define VSN_COMPONENT_TRACE(component, ...)           \
-    ::vsn::logger::Logger::GetDefaultLogger()->Trace( \
-        VSN_SRC_LOC, "[{}] " __VA_ARGS__, component)
+#define VSN_TRACE_LAZY(...) VSN_TRACE(__VA_ARGS__)
+#define VSN_DEBUG_LAZY(...) VSN_DEBUG(__VA_ARGS__)
+#define VSN_INFO_LAZY(...) VSN_INFO(__VA_ARGS__)
+#define VSN_WARN_LAZY(...) VSN_WARN(__VA_ARGS__)
+#define VSN_ERROR_LAZY(...) VSN_ERROR(__VA_ARGS__)
+#define VSN_CRITICAL_LAZY(...) VSN_CRITICAL(__VA_ARGS__)
 
-#define VSN_COMPONENT_DEBUG(component, ...)           \
-    ::vsn::logger::Logger::GetDefaultLogger()->Debug( \
-        VSN_SRC_LOC, "[{}] " __VA_ARGS__, component)
+/**
+ * @brief Component-specific logging macros (adds component prefix)
+ */
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_TRACE
+#define VSN_COMPONENT_TRACE(component, ...)                       \
+    VSN_LOG_COMPONENT_ENABLED(::vsn::logger::E_LogLevel::E_TRACE, \
+                              component, __VA_ARGS__)
+#else
+#define VSN_COMPONENT_TRACE(component, ...) VSN_LOG_DISABLED
+#endif
 
-#define VSN_COMPONENT_INFO(component, ...)           \
-    ::vsn::logger::Logger::GetDefaultLogger()->Info( \
-        VSN_SRC_LOC, "[{}] " __VA_ARGS__, component)
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_DEBUG
+#define VSN_COMPONENT_DEBUG(component, ...)                       \
+    VSN_LOG_COMPONENT_ENABLED(::vsn::logger::E_LogLevel::E_DEBUG, \
+                              component, __VA_ARGS__)
+#else
+#define VSN_COMPONENT_DEBUG(component, ...) VSN_LOG_DISABLED
+#endif
 
-#define VSN_COMPONENT_WARN(component, ...)           \
-    ::vsn::logger::Logger::GetDefaultLogger()->Warn( \
-        VSN_SRC_LOC, "[{}] " __VA_ARGS__, component)
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_INFO
+#define VSN_COMPONENT_INFO(component, ...)                       \
+    VSN_LOG_COMPONENT_ENABLED(::vsn::logger::E_LogLevel::E_INFO, \
+                              component, __VA_ARGS__)
+#else
+#define VSN_COMPONENT_INFO(component, ...) VSN_LOG_DISABLED
+#endif
 
-#define VSN_COMPONENT_ERROR(component, ...)           \
-    ::vsn::logger::Logger::GetDefaultLogger()->Error( \
-        VSN_SRC_LOC, "[{}] " __VA_ARGS__, component)
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_WARN
+#define VSN_COMPONENT_WARN(component, ...)                       \
+    VSN_LOG_COMPONENT_ENABLED(::vsn::logger::E_LogLevel::E_WARN, \
+                              component, __VA_ARGS__)
+#else
+#define VSN_COMPONENT_WARN(component, ...) VSN_LOG_DISABLED
+#endif
 
-#define VSN_COMPONENT_CRITICAL(component, ...)           \
-    ::vsn::logger::Logger::GetDefaultLogger()->Critical( \
-        VSN_SRC_LOC, "[{}] " __VA_ARGS__, component)
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_ERROR
+#define VSN_COMPONENT_ERROR(component, ...)                       \
+    VSN_LOG_COMPONENT_ENABLED(::vsn::logger::E_LogLevel::E_ERROR, \
+                              component, __VA_ARGS__)
+#else
+#define VSN_COMPONENT_ERROR(component, ...) VSN_LOG_DISABLED
+#endif
+
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_CRITICAL
+#define VSN_COMPONENT_CRITICAL(component, ...)                       \
+    VSN_LOG_COMPONENT_ENABLED(::vsn::logger::E_LogLevel::E_CRITICAL, \
+                              component, __VA_ARGS__)
+#else
+#define VSN_COMPONENT_CRITICAL(component, ...) VSN_LOG_DISABLED
+#endif
+
+/**
+ * @brief Rate-limited and sampled logging macros
+ *
+ * @details
+ * VSN_<LEVEL>_EVERY_N(n, ...) emits the first of every n calls,
+ * VSN_<LEVEL>_EVERY_MS(ms, ...) at most one call per interval,
+ * VSN_<LEVEL>_FIRST_N(n, ...) only the first n calls and
+ * VSN_<LEVEL>_RATE(limit, ...) at most limit calls per second with bursts
+ * of up to limit. The state is kept per call site. Suppressed calls
+ * evaluate no argument, and the next emitted record ends with
+ * " [<count> suppressed]". VSN_COMPONENT_<LEVEL>_* variants take the
+ * component first.
+ */
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_TRACE
+#define VSN_TRACE_LIMITED(policy, param, ...)                            \
+    VSN_LOG_LIMITED(::vsn::logger::E_LogLevel::E_TRACE, nullptr, policy, \
+                    param, __VA_ARGS__)
+#define VSN_COMPONENT_TRACE_LIMITED(component, policy, param, ...)           \
+    VSN_LOG_COMPONENT_LIMITED(::vsn::logger::E_LogLevel::E_TRACE, component, \
+                              policy, param, __VA_ARGS__)
+#else
+#define VSN_TRACE_LIMITED(policy, param, ...) VSN_LOG_DISABLED
+#define VSN_COMPONENT_TRACE_LIMITED(component, policy, param, ...) \
+    VSN_LOG_DISABLED
+#endif
+
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_DEBUG
+#define VSN_DEBUG_LIMITED(policy, param, ...)                            \
+    VSN_LOG_LIMITED(::vsn::logger::E_LogLevel::E_DEBUG, nullptr, policy, \
+                    param, __VA_ARGS__)
+#define VSN_COMPONENT_DEBUG_LIMITED(component, policy, param, ...)           \
+    VSN_LOG_COMPONENT_LIMITED(::vsn::logger::E_LogLevel::E_DEBUG, component, \
+                              policy, param, __VA_ARGS__)
+#else
+#define VSN_DEBUG_LIMITED(policy, param, ...) VSN_LOG_DISABLED
+#define VSN_COMPONENT_DEBUG_LIMITED(component, policy, param, ...) \
+    VSN_LOG_DISABLED
+#endif
+
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_INFO
+#define VSN_INFO_LIMITED(policy, param, ...)                            \
+    VSN_LOG_LIMITED(::vsn::logger::E_LogLevel::E_INFO, nullptr, policy, \
+                    param, __VA_ARGS__)
+#define VSN_COMPONENT_INFO_LIMITED(component, policy, param, ...)           \
+    VSN_LOG_COMPONENT_LIMITED(::vsn::logger::E_LogLevel::E_INFO, component, \
+                              policy, param, __VA_ARGS__)
+#else
+#define VSN_INFO_LIMITED(policy, param, ...) VSN_LOG_DISABLED
+#define VSN_COMPONENT_INFO_LIMITED(component, policy, param, ...) \
+    VSN_LOG_DISABLED
+#endif
+
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_WARN
+#define VSN_WARN_LIMITED(policy, param, ...)                            \
+    VSN_LOG_LIMITED(::vsn::logger::E_LogLevel::E_WARN, nullptr, policy, \
+                    param, __VA_ARGS__)
+#define VSN_COMPONENT_WARN_LIMITED(component, policy, param, ...)           \
+    VSN_LOG_COMPONENT_LIMITED(::vsn::logger::E_LogLevel::E_WARN, component, \
+                              policy, param, __VA_ARGS__)
+#else
+#define VSN_WARN_LIMITED(policy, param, ...) VSN_LOG_DISABLED
+#define VSN_COMPONENT_WARN_LIMITED(component, policy, param, ...) \
+    VSN_LOG_DISABLED
+#endif
+
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_ERROR
+#define VSN_ERROR_LIMITED(policy, param, ...)                            \
+    VSN_LOG_LIMITED(::vsn::logger::E_LogLevel::E_ERROR, nullptr, policy, \
+                    param, __VA_ARGS__)
+#define VSN_COMPONENT_ERROR_LIMITED(component, policy, param, ...)           \
+    VSN_LOG_COMPONENT_LIMITED(::vsn::logger::E_LogLevel::E_ERROR, component, \
+                              policy, param, __VA_ARGS__)
+#else
+#define VSN_ERROR_LIMITED(policy, param, ...) VSN_LOG_DISABLED
+#define VSN_COMPONENT_ERROR_LIMITED(component, policy, param, ...) \
+    VSN_LOG_DISABLED
+#endif
+
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_CRITICAL
+#define VSN_CRITICAL_LIMITED(policy, param, ...)                            \
+    VSN_LOG_LIMITED(::vsn::logger::E_LogLevel::E_CRITICAL, nullptr, policy, \
+                    param, __VA_ARGS__)
+#define VSN_COMPONENT_CRITICAL_LIMITED(component, policy, param, ...) \
+    VSN_LOG_COMPONENT_LIMITED(::vsn::logger::E_LogLevel::E_CRITICAL,    \
+                              component, policy, param, __VA_ARGS__)
+#else
+#define VSN_CRITICAL_LIMITED(policy, param, ...) VSN_LOG_DISABLED
+#define VSN_COMPONENT_CRITICAL_LIMITED(component, policy, param, ...) \
+    VSN_LOG_DISABLED
+#endif
+
+#define VSN_TRACE_EVERY_N(n, ...) \
+    VSN_TRACE_LIMITED(LimitEveryN, n, __VA_ARGS__)
+#define VSN_TRACE_EVERY_MS(ms, ...) \
+    VSN_TRACE_LIMITED(LimitEveryMs, ms, __VA_ARGS__)
+#define VSN_TRACE_FIRST_N(n, ...) \
+    VSN_TRACE_LIMITED(LimitFirstN, n, __VA_ARGS__)
+#define VSN_TRACE_RATE(limit, ...) \
+    VSN_TRACE_LIMITED(LimitRate, limit, __VA_ARGS__)
+
+#define VSN_COMPONENT_TRACE_EVERY_N(component, n, ...) \
+    VSN_COMPONENT_TRACE_LIMITED(component, LimitEveryN, n, __VA_ARGS__)
+#define VSN_COMPONENT_TRACE_EVERY_MS(component, ms, ...) \
+    VSN_COMPONENT_TRACE_LIMITED(component, LimitEveryMs, ms, __VA_ARGS__)
+#define VSN_COMPONENT_TRACE_FIRST_N(component, n, ...) \
+    VSN_COMPONENT_TRACE_LIMITED(component, LimitFirstN, n, __VA_ARGS__)
+#define VSN_COMPONENT_TRACE_RATE(component, limit, ...) \
+    VSN_COMPONENT_TRACE_LIMITED(component, LimitRate, limit, __VA_ARGS__)
+
+#define VSN_DEBUG_EVERY_N(n, ...) \
+    VSN_DEBUG_LIMITED(LimitEveryN, n, __VA_ARGS__)
+#define VSN_DEBUG_EVERY_MS(ms, ...) \
+    VSN_DEBUG_LIMITED(LimitEveryMs, ms, __VA_ARGS__)
+#define VSN_DEBUG_FIRST_N(n, ...) \
+    VSN_DEBUG_LIMITED(LimitFirstN, n, __VA_ARGS__)
+#define VSN_DEBUG_RATE(limit, ...) \
+    VSN_DEBUG_LIMITED(LimitRate, limit, __VA_ARGS__)
+
+#define VSN_COMPONENT_DEBUG_EVERY_N(component, n, ...) \
+    VSN_COMPONENT_DEBUG_LIMITED(component, LimitEveryN, n, __VA_ARGS__)
+#define VSN_COMPONENT_DEBUG_EVERY_MS(component, ms, ...) \
+    VSN_COMPONENT_DEBUG_LIMITED(component, LimitEveryMs, ms, __VA_ARGS__)
+#define VSN_COMPONENT_DEBUG_FIRST_N(component, n, ...) \
+    VSN_COMPONENT_DEBUG_LIMITED(component, LimitFirstN, n, __VA_ARGS__)
+#define VSN_COMPONENT_DEBUG_RATE(component, limit, ...) \
+    VSN_COMPONENT_DEBUG_LIMITED(component, LimitRate, limit, __VA_ARGS__)
+
+#define VSN_INFO_EVERY_N(n, ...) \
+    VSN_INFO_LIMITED(LimitEveryN, n, __VA_ARGS__)
+#define VSN_INFO_EVERY_MS(ms, ...) \
+    VSN_INFO_LIMITED(LimitEveryMs, ms, __VA_ARGS__)
+#define VSN_INFO_FIRST_N(n, ...) \
+    VSN_INFO_LIMITED(LimitFirstN, n, __VA_ARGS__)
+#define VSN_INFO_RATE(limit, ...) \
+    VSN_INFO_LIMITED(LimitRate, limit, __VA_ARGS__)
+
+#define VSN_COMPONENT_INFO_EVERY_N(component, n, ...) \
+    VSN_COMPONENT_INFO_LIMITED(component, LimitEveryN, n, __VA_ARGS__)
+#define VSN_COMPONENT_INFO_EVERY_MS(component, ms, ...) \
+    VSN_COMPONENT_INFO_LIMITED(component, LimitEveryMs, ms, __VA_ARGS__)
+#define VSN_COMPONENT_INFO_FIRST_N(component, n, ...) \
+    VSN_COMPONENT_INFO_LIMITED(component, LimitFirstN, n, __VA_ARGS__)
+#define VSN_COMPONENT_INFO_RATE(component, limit, ...) \
+    VSN_COMPONENT_INFO_LIMITED(component, LimitRate, limit, __VA_ARGS__)
+
+#define VSN_WARN_EVERY_N(n, ...) \
+    VSN_WARN_LIMITED(LimitEveryN, n, __VA_ARGS__)
+#define VSN_WARN_EVERY_MS(ms, ...) \
+    VSN_WARN_LIMITED(LimitEveryMs, ms, __VA_ARGS__)
+#define VSN_WARN_FIRST_N(n, ...) \
+    VSN_WARN_LIMITED(LimitFirstN, n, __VA_ARGS__)
+#define VSN_WARN_RATE(limit, ...) \
+    VSN_WARN_LIMITED(LimitRate, limit, __VA_ARGS__)
+
+#define VSN_COMPONENT_WARN_EVERY_N(component, n, ...) \
+    VSN_COMPONENT_WARN_LIMITED(component, LimitEveryN, n, __VA_ARGS__)
+#define VSN_COMPONENT_WARN_EVERY_MS(component, ms, ...) \
+    VSN_COMPONENT_WARN_LIMITED(component, LimitEveryMs, ms, __VA_ARGS__)
+#define VSN_COMPONENT_WARN_FIRST_N(component, n, ...) \
+    VSN_COMPONENT_WARN_LIMITED(component, LimitFirstN, n, __VA_ARGS__)
+#define VSN_COMPONENT_WARN_RATE(component, limit, ...) \
+    VSN_COMPONENT_WARN_LIMITED(component, LimitRate, limit, __VA_ARGS__)
+
+#define VSN_ERROR_EVERY_N(n, ...) \
+    VSN_ERROR_LIMITED(LimitEveryN, n, __VA_ARGS__)
+#define VSN_ERROR_EVERY_MS(ms, ...) \
+    VSN_ERROR_LIMITED(LimitEveryMs, ms, __VA_ARGS__)
+#define VSN_ERROR_FIRST_N(n, ...) \
+    VSN_ERROR_LIMITED(LimitFirstN, n, __VA_ARGS__)
+#define VSN_ERROR_RATE(limit, ...) \
+    VSN_ERROR_LIMITED(LimitRate, limit, __VA_ARGS__)
+
+#define VSN_COMPONENT_ERROR_EVERY_N(component, n, ...) \
+    VSN_COMPONENT_ERROR_LIMITED(component, LimitEveryN, n, __VA_ARGS__)
+#define VSN_COMPONENT_ERROR_EVERY_MS(component, ms, ...) \
+    VSN_COMPONENT_ERROR_LIMITED(component, LimitEveryMs, ms, __VA_ARGS__)
+#define VSN_COMPONENT_ERROR_FIRST_N(component, n, ...) \
+    VSN_COMPONENT_ERROR_LIMITED(component, LimitFirstN, n, __VA_ARGS__)
+#define VSN_COMPONENT_ERROR_RATE(component, limit, ...) \
+    VSN_COMPONENT_ERROR_LIMITED(component, LimitRate, limit, __VA_ARGS__)
+
+#define VSN_CRITICAL_EVERY_N(n, ...) \
+    VSN_CRITICAL_LIMITED(LimitEveryN, n, __VA_ARGS__)
+#define VSN_CRITICAL_EVERY_MS(ms, ...) \
+    VSN_CRITICAL_LIMITED(LimitEveryMs, ms, __VA_ARGS__)
+#define VSN_CRITICAL_FIRST_N(n, ...) \
+    VSN_CRITICAL_LIMITED(LimitFirstN, n, __VA_ARGS__)
+#define VSN_CRITICAL_RATE(limit, ...) \
+    VSN_CRITICAL_LIMITED(LimitRate, limit, __VA_ARGS__)
+
+#define VSN_COMPONENT_CRITICAL_EVERY_N(component, n, ...) \
+    VSN_COMPONENT_CRITICAL_LIMITED(component, LimitEveryN, n, __VA_ARGS__)
+#define VSN_COMPONENT_CRITICAL_EVERY_MS(component, ms, ...) \
+    VSN_COMPONENT_CRITICAL_LIMITED(component, LimitEveryMs, ms, __VA_ARGS__)
+#define VSN_COMPONENT_CRITICAL_FIRST_N(component, n, ...) \
+    VSN_COMPONENT_CRITICAL_LIMITED(component, LimitFirstN, n, __VA_ARGS__)
+#define VSN_COMPONENT_CRITICAL_RATE(component, limit, ...) \
+    VSN_COMPONENT_CRITICAL_LIMITED(component, LimitRate, limit, __VA_ARGS__)
+
+/**
+ * @brief Structured record with typed key-value fields
+ *
+ * @details
+ * message is a string literal logged as is, followed by key, value pairs:
+ * VSN_INFO_KV("request done", "latency_us", latency, "status", code).
+ * Values keep their type up to the sink, see kv.h. Arguments are only
+ * evaluated when the level is enabled.
+ */
+#define VSN_LOG_KV(level, componentPtr, ...)                                 \
+    do {                                                                     \
+        static_assert(::vsn::logger::FormatLength(                           \
+                          VSN_FIRST_ARG(__VA_ARGS__, 0)) <=                  \
+                          ::vsn::logger::k_maxFormatLength,                  \
+                      "Log message too long");                               \
+        static ::vsn::logger::LogSite_t vsnLogSite(                          \
+            __FILE__, static_cast<std::uint32_t>(__LINE__), __func__, level, \
+            VSN_FIRST_ARG(__VA_ARGS__, 0));                                  \
+        if (::vsn::logger::Logger::PassesLevelFloor(level)) {                \
+            ::vsn::logger::Logger& vsnLogger =                               \
+                *::vsn::logger::Logger::GetDefaultLogger();                  \
+            if (vsnLogger.ShouldLog(level, componentPtr)) {                  \
+                ::vsn::logger::TouchLogSite(vsnLogSite);                     \
+                static_cast<void>(vsnLogger.LogKv(vsnLogSite, componentPtr,  \
+                                                  __VA_ARGS__));             \
+            }                                                                \
+        }                                                                    \
+    } while (false)
+
+/**
+ * @brief Structured record tagged with a component
+ */
+#define VSN_LOG_COMPONENT_KV(level, component, ...)                      \
+    do {                                                                 \
+        static ::vsn::logger::ComponentRef_t vsnComponentRef(component); \
+        VSN_LOG_KV(level, &vsnComponentRef.Get(), __VA_ARGS__);          \
+    } while (false)
+
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_TRACE
+#define VSN_TRACE_KV(...) \
+    VSN_LOG_KV(::vsn::logger::E_LogLevel::E_TRACE, nullptr, __VA_ARGS__)
+#define VSN_COMPONENT_TRACE_KV(component, ...) \
+    VSN_LOG_COMPONENT_KV(::vsn::logger::E_LogLevel::E_TRACE, component, \
+                         __VA_ARGS__)
+#else
+#define VSN_TRACE_KV(...) VSN_LOG_DISABLED
+#define VSN_COMPONENT_TRACE_KV(component, ...) VSN_LOG_DISABLED
+#endif
+
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_DEBUG
+#define VSN_DEBUG_KV(...) \
+    VSN_LOG_KV(::vsn::logger::E_LogLevel::E_DEBUG, nullptr, __VA_ARGS__)
+#define VSN_COMPONENT_DEBUG_KV(component, ...) \
+    VSN_LOG_COMPONENT_KV(::vsn::logger::E_LogLevel::E_DEBUG, component, \
+                         __VA_ARGS__)
+#else
+#define VSN_DEBUG_KV(...) VSN_LOG_DISABLED
+#define VSN_COMPONENT_DEBUG_KV(component, ...) VSN_LOG_DISABLED
+#endif
+
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_INFO
+#define VSN_INFO_KV(...) \
+    VSN_LOG_KV(::vsn::logger::E_LogLevel::E_INFO, nullptr, __VA_ARGS__)
+#define VSN_COMPONENT_INFO_KV(component, ...) \
+    VSN_LOG_COMPONENT_KV(::vsn::logger::E_LogLevel::E_INFO, component, \
+                         __VA_ARGS__)
+#else
+#define VSN_INFO_KV(...) VSN_LOG_DISABLED
+#define VSN_COMPONENT_INFO_KV(component, ...) VSN_LOG_DISABLED
+#endif
+
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_WARN
+#define VSN_WARN_KV(...) \
+    VSN_LOG_KV(::vsn::logger::E_LogLevel::E_WARN, nullptr, __VA_ARGS__)
+#define VSN_COMPONENT_WARN_KV(component, ...) \
+    VSN_LOG_COMPONENT_KV(::vsn::logger::E_LogLevel::E_WARN, component, \
+                         __VA_ARGS__)
+#else
+#define VSN_WARN_KV(...) VSN_LOG_DISABLED
+#define VSN_COMPONENT_WARN_KV(component, ...) VSN_LOG_DISABLED
+#endif
+
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_ERROR
+#define VSN_ERROR_KV(...) \
+    VSN_LOG_KV(::vsn::logger::E_LogLevel::E_ERROR, nullptr, __VA_ARGS__)
+#define VSN_COMPONENT_ERROR_KV(component, ...) \
+    VSN_LOG_COMPONENT_KV(::vsn::logger::E_LogLevel::E_ERROR, component, \
+                         __VA_ARGS__)
+#else
+#define VSN_ERROR_KV(...) VSN_LOG_DISABLED
+#define VSN_COMPONENT_ERROR_KV(component, ...) VSN_LOG_DISABLED
+#endif
+
+#if VSN_ACTIVE_LEVEL <= VSN_LEVEL_CRITICAL
+#define VSN_CRITICAL_KV(...) \
+    VSN_LOG_KV(::vsn::logger::E_LogLevel::E_CRITICAL, nullptr, __VA_ARGS__)
+#define VSN_COMPONENT_CRITICAL_KV(component, ...) \
+    VSN_LOG_COMPONENT_KV(::vsn::logger::E_LogLevel::E_CRITICAL, component, \
+                         __VA_ARGS__)
+#else
+#define VSN_CRITICAL_KV(...) VSN_LOG_DISABLED
+#define VSN_COMPONENT_CRITICAL_KV(component, ...) VSN_LOG_DISABLED
+#endif
 
 /**
  * @brief Initialize logging system
@@ -118,3 +621,57 @@
 #define VSN_FLUSH_LOGS() ::vsn::logger::Logger::GetDefaultLogger()->Flush()
 
 #define VSN_SHUTDOWN_LOGGING() ::vsn::logger::Logger::Shutdown()
+
+/**
+ * @brief Reserve per-thread logging resources at thread start
+ */
+#define VSN_PREPARE_THREAD() \
+    ::vsn::logger::Logger::GetDefaultLogger()->PrepareThread()
+
+/**
+ * @brief Unique identifier for a declaration made by a macro
+ */
+#define VSN_CONCAT_IMPL(a, b) a##b
+#define VSN_CONCAT(a, b) VSN_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Constant-initialized timer site of the expansion
+ */
+#define VSN_TIMER_SITE(level, name)                                       \
+    ([]() -> ::vsn::logger::TimerSite_t& {                                \
+        static ::vsn::logger::TimerSite_t vsnTimerSite(                   \
+            name, __FILE__, static_cast<std::uint32_t>(__LINE__), level); \
+        return vsnTimerSite;                                              \
+    }())
+
+/**
+ * @brief Time the rest of the enclosing scope
+ *
+ * @details
+ * Durations are aggregated per site and summarized periodically at the
+ * given level, see timer.h. Nothing is measured while the level is
+ * disabled on the default logger.
+ */
+#define VSN_SCOPED_TIMER_LEVEL(level, name)                            \
+    ::vsn::logger::ScopedTimer_t VSN_CONCAT(vsnScopedTimer, __LINE__)( \
+        VSN_TIMER_SITE(level, name))
+
+/**
+ * @brief Time the statement or block that follows
+ *
+ * @details
+ * VSN_TIMED_BLOCK("parse") { ... } runs the block once; break leaves it.
+ */
+#define VSN_TIMED_BLOCK_LEVEL(level, name)           \
+    for (::vsn::logger::ScopedTimer_t vsnTimedBlock( \
+             VSN_TIMER_SITE(level, name));           \
+         vsnTimedBlock.Pending();)
+
+/**
+ * @brief Timers summarized at INFO
+ */
+#define VSN_SCOPED_TIMER(name) \
+    VSN_SCOPED_TIMER_LEVEL(::vsn::logger::E_LogLevel::E_INFO, name)
+
+#define VSN_TIMED_BLOCK(name) \
+    VSN_TIMED_BLOCK_LEVEL(::vsn::logger::E_LogLevel::E_INFO, name)
@@ -0,0 +1,175 @@
+/**
+ * @file ratelimit.h
+ * @brief Per-call-site rate limiting for VSNLogger macros
+ *
+ * @details
+ * Each rate-limited macro expansion owns one RateLimit_t with static
+ * storage. The policies below update it with lock-free atomics and decide
+ * whether the statement emits; a suppressed statement returns before any
+ * argument is evaluated or formatted. The number of suppressed calls is
+ * handed to the next record that is emitted from the same site.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace vsn {
+namespace logger {
+
+/**
+ * @brief Lock-free state of one rate-limited call site
+ */
+struct RateLimit_t {
+    constexpr RateLimit_t(void) : m_count(0U), m_suppressed(0U), m_mark(0) {}
+
+    /* Sites are identified by address */
+    RateLimit_t(const RateLimit_t&) = delete;
+    RateLimit_t& operator=(const RateLimit_t&) = delete;
+
+    std::atomic<std::uint64_t> m_count;      /**< Calls seen by the site */
+    std::atomic<std::uint64_t> m_suppressed; /**< Suppressed since emitting */
+    std::atomic<std::int64_t> m_mark;        /**< Policy time mark in ns */
+};
+
+namespace detail {
+
+/**
+ * @brief Monotonic time in nanoseconds, never zero
+ */
+inline std::int64_t RateLimitNow(void) {
+    return static_cast<std::int64_t>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+                   .count()) +
+           1;
+}
+
+/**
+ * @brief Record the outcome of a policy decision
+ *
+ * @param[in,out] state Site state
+ * @param[in] pass Policy decision
+ * @param[out] suppressed Calls suppressed since the last emitted record
+ * @return pass
+ */
+inline bool SettleRateLimit(RateLimit_t& state, bool pass,
+                            std::uint64_t& suppressed) {
+    if (pass) {
+        suppressed = state.m_suppressed.exchange(0U, std::memory_order_relaxed);
+    } else {
+        state.m_suppressed.fetch_add(1U, std::memory_order_relaxed);
+    }
+    return pass;
+}
+
+} /* namespace detail */
+
+/**
+ * @brief Emit the first of every n calls
+ *
+ * @param[in,out] state Site state
+ * @param[in] n Sampling period, 0 and 1 emit every call
+ * @param[out] suppressed Calls suppressed since the last emitted record
+ * @return true if the call emits
+ */
+inline bool LimitEveryN(RateLimit_t& state, std::uint64_t n,
+                        std::uint64_t& suppressed) {
+    const std::uint64_t count =
+        state.m_count.fetch_add(1U, std::memory_order_relaxed);
+    return detail::SettleRateLimit(state, (n <= 1U) || (0U == (count % n)),
+                                   suppressed);
+}
+
+/**
+ * @brief Emit only the first n calls
+ *
+ * @param[in,out] state Site state
+ * @param[in] n Number of calls emitted
+ * @param[out] suppressed Always 0, nothing is emitted after suppression
+ * @return true if the call emits
+ */
+inline bool LimitFirstN(RateLimit_t& state, std::uint64_t n,
+                        std::uint64_t& suppressed) {
+    /* Stop counting once the limit is reached so the counter cannot wrap */
+    if (state.m_count.load(std::memory_order_relaxed) >= n) {
+        return false;
+    }
+    return detail::SettleRateLimit(
+        state, state.m_count.fetch_add(1U, std::memory_order_relaxed) < n,
+        suppressed);
+}
+
+/**
+ * @brief Emit at most one call per interval
+ *
+ * @param[in,out] state Site state
+ * @param[in] ms Minimum interval between emitted calls in milliseconds
+ * @param[out] suppressed Calls suppressed since the last emitted record
+ * @return true if the call emits
+ */
+inline bool LimitEveryMs(RateLimit_t& state, std::uint64_t ms,
+                         std::uint64_t& suppressed) {
+    const std::int64_t now = detail::RateLimitNow();
+    const std::int64_t interval = static_cast<std::int64_t>(ms) * 1000000;
+    std::int64_t last = state.m_mark.load(std::memory_order_relaxed);
+
+    /* One caller per interval wins the exchange */
+    const bool pass =
+        ((0 == last) || ((now - last) >= interval)) &&
+        state.m_mark.compare_exchange_strong(last, now,
+                                             std::memory_order_relaxed);
+    return detail::SettleRateLimit(state, pass, suppressed);
+}
+
+/**
+ * @brief Token bucket emitting at most limit calls per second
+ *
+ * @details
+ * Implemented as a generic cell rate algorithm: the mark is the time at
+ * which the bucket is full again, so one CAS replaces a token counter and
+ * a refill timestamp. Bursts of up to limit calls pass.
+ *
+ * @param[in,out] state Site state
+ * @param[in] limit Calls per second, 0 suppresses every call
+ * @param[out] suppressed Calls suppressed since the last emitted record
+ * @return true if the call emits
+ */
+inline bool LimitRate(RateLimit_t& state, std::uint64_t limit,
+                      std::uint64_t& suppressed) {
+    static constexpr std::int64_t k_second = 1000000000;
+
+    if (0U == limit) {
+        return detail::SettleRateLimit(state, false, suppressed);
+    }
+
+    const std::int64_t now = detail::RateLimitNow();
+    const std::int64_t interval =
+        (limit >= static_cast<std::uint64_t>(k_second))
+            ? 1
+            : (k_second / static_cast<std::int64_t>(limit));
+    std::int64_t full = state.m_mark.load(std::memory_order_relaxed);
+
+    bool pass = false;
+    for (;;) {
+        const std::int64_t start = std::max(full, now);
+        if ((start + interval - now) > k_second) {
+            break;
+        }
+        if (state.m_mark.compare_exchange_weak(full, start + interval,
+                                               std::memory_order_relaxed)) {
+            pass = true;
+            break;
+        }
+    }
+    return detail::SettleRateLimit(state, pass, suppressed);
+}
+
+} /* namespace logger */
+} /* namespace vsn */
@@ -0,0 +1,184 @@
+/**
+ * @file recorder.h
+ * @brief In-memory flight recorder for VSNLogger
+ *
+ * @details
+ * The flight recorder keeps the most recent records below the active level
+ * in a fixed ring instead of writing them. Records are captured like
+ * deferred records: arguments are copied raw when possible, so capturing
+ * costs no formatting and no sink I/O. When a record at or above the
+ * trigger level is logged, the ring is written ahead of it, giving the
+ * debug context that led to the failure at production log levels. Calls
+ * with a lazy argument (see lazy.h) are not captured: capturing would run
+ * the closure for a disabled level.
+ *
+ * Each slot has its own spin lock, so producers only contend when they
+ * claim the same slot, and a dump copies one record at a time.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <spdlog/logger.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#include "error_codes.h"
+#include "vsnlogger/component.h"
+#include "vsnlogger/deferred.h"
+#include "vsnlogger/format.h"
+
+namespace vsn {
+namespace logger {
+
+namespace async {
+class AsyncBackend;
+} /* namespace async */
+
+/**
+ * @brief Fixed ring of recent records below the active level
+ */
+class FlightRecorder {
+   public:
+    /** Largest number of records a recorder holds */
+    static constexpr std::uint32_t k_maxCapacity = 65536U;
+
+    /**
+     * @brief Allocate the ring
+     *
+     * @param[in] capacity Number of records kept, 1 to k_maxCapacity
+     */
+    explicit FlightRecorder(std::uint32_t capacity);
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    /**
+     * @brief Keep a record in the ring, replacing the oldest one
+     *
+     * @param[in] limit Maximum length of eagerly formatted text
+     * @param[in] loc Call site
+     * @param[in] level Record severity
+     * @param[in] component Component handle or nullptr
+     * @param[in] suppressed Calls suppressed by the site's rate limit
+     * @param[in] format Compiled or runtime format tag
+     * @param[in] fmt Format string
+     * @param[in] args Format arguments, none of them lazy
+     */
+    template <typename Format, typename... Args>
+    void Capture(std::size_t limit, const spdlog::source_loc& loc,
+                 E_LogLevel level, const Component_t* component,
+                 std::uint64_t suppressed, const Format& format,
+                 const char* fmt, const Args&... args);
+
+    /**
+     * @brief Keep an already encoded record, replacing the oldest one
+     *
+     * @param[in] record Record to keep, key-value records included
+     */
+    void Store(const async::AsyncRecord_t& record);
+
+    /**
+     * @brief Get the ring capacity
+     *
+     * @return Number of records kept
+     */
+    std::uint32_t GetCapacity(void) const { return m_capacity; }
+
+    /**
+     * @brief Write the records captured since the last dump, oldest first
+     *
+     * @details
+     * With an asynchronous backend the records are queued as they are and
+     * rendered by the writer threads; otherwise they are rendered here and
+     * written to the logger's sinks, bypassing its level.
+     *
+     * @param[in] logger Logger whose sinks receive the records
+     * @param[in] backend Asynchronous backend or nullptr
+     * @param[in] limit Maximum length of decoded text
+     * @return Operation result code
+     */
+    E_Result Dump(spdlog::logger& logger, async::AsyncBackend* backend,
+                  std::size_t limit);
+
+   private:
+    /**
+     * @brief One ring entry
+     */
+    struct Slot_t {
+        std::atomic<bool> m_busy{false}; /**< Spin lock */
+        std::uint64_t m_ticket = 0U;     /**< Capture number plus one */
+        async::AsyncRecord_t m_record;   /**< Captured record */
+    };
+
+    /** Preallocated ring */
+    std::unique_ptr<Slot_t[]> m_slots;
+
+    /** Ring capacity in records */
+    const std::uint32_t m_capacity;
+
+    /** Number of records captured so far */
+    std::atomic<std::uint64_t> m_next;
+
+    /** Captures already written, guarded by m_dumpMutex */
+    std::uint64_t m_dumped;
+
+    /** Serializes dumps */
+    std::mutex m_dumpMutex;
+};
+
+template <typename Format, typename... Args>
+void FlightRecorder::Capture(std::size_t limit, const spdlog::source_loc& loc,
+                             E_LogLevel level, const Component_t* component,
+                             std::uint64_t suppressed, const Format& format,
+                             const char* fmt, const Args&... args) {
+    async::AsyncRecord_t& record = async::detail::StagingRecord();
+
+    /* Copy raw arguments when possible, formatting waits for a dump */
+    bool encoded = false;
+    if constexpr (async::detail::IsDeferrable<Args...>::value) {
+        encoded = async::detail::EncodeArgs<Format>(record, fmt, args...);
+    }
+
+    if (!encoded) {
+        spdlog::string_view_t message = detail::FormatBounded(
+            limit, (nullptr != component) ? component->m_prefix : nullptr,
+            (nullptr != component) ? component->m_prefixLength : 0U, format,
+            fmt, args...);
+        if (suppressed > 0U) {
+            char* const buffer = detail::MessageBuffer();
+            message = spdlog::string_view_t(
+                buffer, detail::AppendSuppressed(buffer, message.size(), limit,
+                                                 suppressed));
+        }
+
+        std::size_t size = std::min(message.size(), async::k_maxRecordPayload);
+        std::memcpy(record.m_payload, message.data(), size);
+        if (message.size() > async::k_maxRecordPayload) {
+            size = detail::MarkTruncated(
+                reinterpret_cast<char*>(record.m_payload),
+                async::k_maxRecordPayload);
+        }
+        record.m_decode = nullptr;
+        record.m_format = nullptr;
+        record.m_size = static_cast<std::uint16_t>(size);
+    }
+
+    record.m_ticks = detail::ClockTicks();
+    record.m_source = loc;
+    record.m_threadId = async::detail::ThreadId();
+    record.m_level = static_cast<spdlog::level::level_enum>(level);
+    record.m_component = component;
+    record.m_suppressed = suppressed;
+    Store(record);
+}
+
+} /* namespace logger */
+} /* namespace vsn */
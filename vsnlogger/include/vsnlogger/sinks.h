@@ -18,8 +18,9 @@
 
 #include "error_codes.h"
 
-/* Forward declaration of spdlog sink */
+/* Forward declaration of spdlog sink and formatter */
 namespace spdlog {
+class formatter;
 namespace sinks {
 class sink;
 }
@@ -27,6 +28,12 @@ class sink;
 
 namespace vsn {
 namespace logger {
+
+/* Forward declaration of asynchronous backend */
+namespace async {
+class AsyncBackend;
+}
+
 namespace sinks {
 
 /**
@@ -71,6 +78,34 @@ std::shared_ptr<spdlog::sinks::sink> CreateSyslogSink(
  */
 std::shared_ptr<spdlog::sinks::sink> CreateNullSink(void);
 
+/**
+ * @brief Create a sink writing into a crash-surviving memory-mapped ring
+ *
+ * @details
+ * Records are formatted and copied into the mapped file without a system
+ * call; the most recent capacity bytes survive a crash of the process.
+ * Combine with crash::InstallCrashHandler() to record the fatal signal.
+ *
+ * @param[in] path Ring file path, an existing file is kept as path.prev
+ * @param[in] capacity Ring data size in bytes
+ * @return Pointer to created sink or nullptr on failure
+ */
+std::shared_ptr<spdlog::sinks::sink> CreateCrashRingSink(
+    const std::string& path, std::uint64_t capacity);
+
+/**
+ * @brief Create a sink that hands records to an asynchronous backend
+ *
+ * @details
+ * Patterns and formatters installed on this sink are forwarded to the
+ * backend's destination sinks.
+ *
+ * @param[in] backend Backend owning the destination sinks
+ * @return Pointer to created sink or nullptr on failure
+ */
+std::shared_ptr<spdlog::sinks::sink> CreateAsyncSink(
+    std::shared_ptr<async::AsyncBackend> backend);
+
 /**
  * @brief Create a multi-sink with multiple outputs
  *
@@ -82,6 +117,73 @@ std::shared_ptr<spdlog::sinks::sink> CreateNullSink(void);
 std::vector<std::shared_ptr<spdlog::sinks::sink>> CreateMultiSink(
     bool console, const std::string& logFile, bool syslog);
 
+/**
+ * @brief Create a multi-sink whose outputs share a dedup stage
+ *
+ * @param[in] console Enable console output
+ * @param[in] logFile Path to log file (empty to disable)
+ * @param[in] syslog Enable syslog output
+ * @param[in] dedupWindowMs Collapsing window, 0 to disable the stage
+ * @return Vector of created sinks, a single dedup sink if enabled
+ */
+std::vector<std::shared_ptr<spdlog::sinks::sink>> CreateMultiSink(
+    bool console, const std::string& logFile, bool syslog,
+    std::uint32_t dedupWindowMs);
+
+/**
+ * @brief Create a sink collapsing repeated records in front of other sinks
+ *
+ * @details
+ * A record with the same call site, level and message as one forwarded
+ * less than windowMs earlier is counted instead of forwarded. The count is
+ * emitted as one "\"<message>\" repeated N times" record, quoting the
+ * start of the message, when the window ends, when another record needs
+ * the table slot, or on flush. The table has a fixed size and nothing is
+ * allocated per record.
+ *
+ * @param[in] sinks Destination sinks
+ * @param[in] windowMs Collapsing window in milliseconds, must be non-zero
+ * @return Pointer to created sink or nullptr on failure
+ */
+std::shared_ptr<spdlog::sinks::sink> CreateDedupSink(
+    std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks,
+    std::uint32_t windowMs);
+
+/**
+ * @brief Create a sink formatting each record once for several outputs
+ *
+ * @details
+ * Console, file and crash ring sinks sharing a formatter are formatted
+ * once per record and receive the same text; other sinks format records
+ * themselves. Patterns and formatters installed on this sink apply to all
+ * outputs.
+ *
+ * @param[in] sinks Destination sinks
+ * @return Pointer to created sink or nullptr on failure
+ */
+std::shared_ptr<spdlog::sinks::sink> CreateFanoutSink(
+    std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks);
+
+/**
+ * @brief Install a formatter on one output of a fan-out sink
+ *
+ * @details
+ * Outputs given the same key are formatted in one pass. Without a fan-out
+ * sink the formatter is installed on the output directly. Installing a
+ * pattern or formatter on the fan-out sink itself applies to all outputs
+ * again.
+ *
+ * @param[in] fanout Sink created by CreateFanoutSink(), or null
+ * @param[in] output Output sink, a destination of fanout
+ * @param[in] formatter Formatter of the output
+ * @param[in] key Format identity, such as the pattern name
+ * @return Operation result code
+ */
+E_Result SetOutputFormatter(
+    const std::shared_ptr<spdlog::sinks::sink>& fanout,
+    const std::shared_ptr<spdlog::sinks::sink>& output,
+    std::unique_ptr<spdlog::formatter> formatter, const std::string& key);
+
 /**
  * @brief Get current sink allocation count
  *
@@ -0,0 +1,134 @@
+/**
+ * @file site.h
+ * @brief Static call-site descriptors for VSNLogger macros
+ *
+ * @details
+ * Every logging macro expansion owns one LogSite_t with static storage. Its
+ * fields are computed at compile time (basename of the source file, line,
+ * function, level, format string and its length) and the object is
+ * constant-initialized, so no guard variable or string scan runs per call.
+ * A site is added to a process-wide registry the first time it is enabled,
+ * which lets tooling enumerate the sites that have been reached.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "error_codes.h"
+
+namespace vsn {
+namespace logger {
+
+/* Severity levels, defined in logger.h */
+enum class E_LogLevel : std::uint8_t;
+
+/** Longest format string accepted by the logging macros */
+static constexpr std::size_t k_maxFormatLength = 256U;
+
+/**
+ * @brief Get the part of a path after the last separator
+ *
+ * @param[in] path Source file path
+ * @return Pointer into path at the file name
+ */
+constexpr const char* Basename(const char* path) {
+    const char* filename = path;
+    for (const char* p = path; '\0' != *p; ++p) {
+        if (('/' == *p) || ('\\' == *p)) {
+            filename = p + 1;
+        }
+    }
+    return filename;
+}
+
+/**
+ * @brief Get the length of a null-terminated string
+ *
+ * @param[in] text String to measure
+ * @return Number of characters before the terminator
+ */
+constexpr std::size_t FormatLength(const char* text) {
+    std::size_t length = 0U;
+    while ('\0' != text[length]) {
+        ++length;
+    }
+    return length;
+}
+
+/**
+ * @brief Compile-time description of one logging statement
+ *
+ * @details
+ * Instances are created by the VSN_* macros as function-local statics with
+ * a constant initializer. Only the registration link is written at run time.
+ */
+struct LogSite_t {
+    constexpr LogSite_t(const char* file, std::uint32_t line,
+                        const char* function, E_LogLevel level,
+                        const char* format)
+        : m_filename(Basename(file)),
+          m_line(line),
+          m_function(function),
+          m_level(level),
+          m_format(format),
+          m_registered(false),
+          m_next(nullptr) {}
+
+    /* Sites are identified by address */
+    LogSite_t(const LogSite_t&) = delete;
+    LogSite_t& operator=(const LogSite_t&) = delete;
+
+    const char* const m_filename; /**< Source file name without path */
+    const std::uint32_t m_line;   /**< Source line */
+    const char* const m_function; /**< Enclosing function */
+    const E_LogLevel m_level;     /**< Severity of the statement */
+    const char* const m_format;   /**< Format string */
+
+    std::atomic<bool> m_registered; /**< Site is linked into the registry */
+    const LogSite_t* m_next;        /**< Next registered site */
+};
+
+/**
+ * @brief Callback receiving each registered site
+ */
+using LogSiteVisitor_t = void (*)(const LogSite_t& site, void* context);
+
+/**
+ * @brief Link a site into the registry
+ *
+ * @details
+ * Called by the macros the first time a site is enabled; later calls for
+ * the same site return immediately.
+ *
+ * @param[in,out] site Site to register
+ */
+void RegisterLogSite(LogSite_t& site);
+
+/**
+ * @brief Visit every registered site
+ *
+ * @param[in] visitor Callback invoked once per site
+ * @param[in] context Opaque pointer handed to the visitor
+ * @return Operation result code
+ */
+E_Result EnumerateLogSites(LogSiteVisitor_t visitor, void* context);
+
+/**
+ * @brief Register a site on first use
+ *
+ * @param[in,out] site Site reached by the caller
+ */
+inline void TouchLogSite(LogSite_t& site) {
+    if (!site.m_registered.load(std::memory_order_relaxed)) {
+        RegisterLogSite(site);
+    }
+}
+
+} /* namespace logger */
+} /* namespace vsn */
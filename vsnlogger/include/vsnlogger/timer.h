@@ -0,0 +1,212 @@
+/**
+ * @file timer.h
+ * @brief Scoped latency timers with per-site histograms for VSNLogger
+ *
+ * @details
+ * A timer site is a static descriptor owned by one VSN_SCOPED_TIMER or
+ * VSN_TIMED_BLOCK expansion. Each measured duration lands in a log-linear
+ * histogram owned by the calling thread, so recording is a handful of
+ * relaxed stores without contention. Values below 16 ns are exact; above,
+ * every power of two is split into 16 buckets, bounding the error of a
+ * reported percentile to about 3 percent.
+ *
+ * Instead of one line per call, each site periodically logs the count,
+ * p50, p99, p99.9 and maximum of the interval at the site's level, so the
+ * summaries obey level filtering. A site whose level is disabled when the
+ * scope is entered does not read the clock at all.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "error_codes.h"
+#include "vsnlogger/logger.h"
+#include "vsnlogger/site.h"
+
+namespace vsn {
+namespace logger {
+
+/** Number of timer sites that can be registered */
+static constexpr std::uint32_t k_maxTimerSites = 256U;
+
+/** ID of a timer site that is not registered yet */
+static constexpr std::uint32_t k_unregisteredTimer = 0xFFFFFFFFU;
+
+/** ID of a timer site that did not fit the registry */
+static constexpr std::uint32_t k_droppedTimer = 0xFFFFFFFEU;
+
+/** Buckets per power of two, values below it are exact */
+static constexpr std::uint32_t k_timerSubBuckets = 16U;
+
+/** Durations from 2^k_timerMaxExponent ns (about 18 minutes) clamp */
+static constexpr std::uint32_t k_timerMaxExponent = 40U;
+
+/** Histogram size */
+static constexpr std::uint32_t k_timerBucketCount =
+    k_timerSubBuckets + ((k_timerMaxExponent - 4U) * k_timerSubBuckets);
+
+/** Default interval between summaries */
+static constexpr std::uint32_t k_defaultTimerReportMs = 10000U;
+
+/**
+ * @brief Static descriptor of one timed scope
+ */
+struct TimerSite_t {
+    constexpr TimerSite_t(const char* name, const char* file,
+                          std::uint32_t line, E_LogLevel level)
+        : m_name(name),
+          m_filename(Basename(file)),
+          m_line(line),
+          m_level(level),
+          m_id(k_unregisteredTimer) {}
+
+    /* Sites are identified by address */
+    TimerSite_t(const TimerSite_t&) = delete;
+    TimerSite_t& operator=(const TimerSite_t&) = delete;
+
+    const char* const m_name;        /**< Name shown in summaries */
+    const char* const m_filename;    /**< Source file name without path */
+    const std::uint32_t m_line;      /**< Source line */
+    const E_LogLevel m_level;        /**< Level of the summaries */
+    std::atomic<std::uint32_t> m_id; /**< Registry index, assigned lazily */
+};
+
+namespace detail {
+
+/**
+ * @brief Monotonic time in nanoseconds for timers
+ */
+inline std::uint64_t TimerNow(void) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+/**
+ * @brief Histogram bucket of a duration
+ *
+ * @param[in] ns Duration in nanoseconds
+ * @return Bucket index below k_timerBucketCount
+ */
+inline std::uint32_t TimerBucket(std::uint64_t ns) {
+    if (ns < k_timerSubBuckets) {
+        return static_cast<std::uint32_t>(ns);
+    }
+    if (ns >= (static_cast<std::uint64_t>(1U) << k_timerMaxExponent)) {
+        return k_timerBucketCount - 1U;
+    }
+
+    /* Keep the top 5 bits: the leading one and 4 bits of sub-bucket */
+    const std::uint32_t exponent =
+        63U - static_cast<std::uint32_t>(__builtin_clzll(ns));
+    const std::uint32_t shift = exponent - 4U;
+    return k_timerSubBuckets + (shift * k_timerSubBuckets) +
+           static_cast<std::uint32_t>((ns >> shift) - k_timerSubBuckets);
+}
+
+/**
+ * @brief Representative duration of a bucket, its midpoint
+ *
+ * @param[in] bucket Bucket index
+ * @return Duration in nanoseconds
+ */
+inline std::uint64_t TimerBucketValue(std::uint32_t bucket) {
+    if (bucket < k_timerSubBuckets) {
+        return bucket;
+    }
+
+    const std::uint32_t offset = bucket - k_timerSubBuckets;
+    const std::uint32_t shift = offset / k_timerSubBuckets;
+    const std::uint64_t sub = k_timerSubBuckets + (offset % k_timerSubBuckets);
+    return (sub << shift) + ((static_cast<std::uint64_t>(1U) << shift) >> 1U);
+}
+
+} /* namespace detail */
+
+/**
+ * @brief Add a duration to the calling thread's histogram of a site
+ *
+ * @details
+ * Also logs the summaries of all sites when the report interval elapsed.
+ *
+ * @param[in,out] site Timer site, registered on first use
+ * @param[in] start Start time from detail::TimerNow()
+ * @param[in] end End time from detail::TimerNow()
+ */
+void RecordTimer(TimerSite_t& site, std::uint64_t start, std::uint64_t end);
+
+/**
+ * @brief Log the summary of every site timed since the last report
+ *
+ * @param[in] logger Logger receiving the summaries
+ * @return Operation result code
+ */
+E_Result ReportTimers(Logger& logger);
+
+/**
+ * @brief Set the interval between automatic summaries
+ *
+ * @param[in] intervalMs Interval in milliseconds, 0 reports only on
+ *            ReportTimers() and at shutdown
+ * @return Operation result code
+ */
+E_Result SetTimerReportInterval(std::uint32_t intervalMs);
+
+/**
+ * @brief Measure the lifetime of a scope
+ */
+class ScopedTimer_t {
+   public:
+    /**
+     * @brief Start timing if the site's level is enabled
+     *
+     * @param[in,out] site Timer site
+     */
+    explicit ScopedTimer_t(TimerSite_t& site)
+        : m_site((Logger::PassesLevelFloor(site.m_level) &&
+                  Logger::GetDefaultLogger()->ShouldLog(site.m_level))
+                     ? &site
+                     : nullptr),
+          m_start((nullptr != m_site) ? detail::TimerNow() : 0U),
+          m_pending(true) {}
+
+    ~ScopedTimer_t(void) {
+        if (nullptr != m_site) {
+            RecordTimer(*m_site, m_start, detail::TimerNow());
+        }
+    }
+
+    ScopedTimer_t(const ScopedTimer_t&) = delete;
+    ScopedTimer_t& operator=(const ScopedTimer_t&) = delete;
+
+    /**
+     * @brief Run the body of VSN_TIMED_BLOCK exactly once
+     *
+     * @return true on the first call only
+     */
+    bool Pending(void) {
+        const bool pending = m_pending;
+        m_pending = false;
+        return pending;
+    }
+
+   private:
+    /** Site being timed, null when its level is disabled */
+    TimerSite_t* const m_site;
+
+    /** Start time in nanoseconds */
+    const std::uint64_t m_start;
+
+    /** Body of a timed block has not run yet */
+    bool m_pending;
+};
+
+} /* namespace logger */
+} /* namespace vsn */
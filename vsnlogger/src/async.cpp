@@ -0,0 +1,885 @@
+/**
+ * @file async.cpp
+ * @brief Implementation of the asynchronous logging backend for VSNLogger
+ *
+ * @details
+ * The shared queue is a fixed ring of records allocated once at
+ * construction, so steady-state operation performs no heap allocation.
+ * Producers copy either the formatted payload or, in deferred mode, the raw
+ * argument bytes under a short critical section; argument formatting,
+ * pattern formatting and all sink I/O happen on the writer threads.
+ *
+ * In per-thread mode each producing thread owns a single-producer ring
+ * allocated on its first log call, and no lock is taken on the logging path.
+ * One writer stages the oldest record of every ring and always writes the
+ * staged record with the earliest capture time. Output is therefore ordered
+ * by timestamp among the records visible to the writer; a record published
+ * after a later-stamped one was written cannot be reordered before it.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include "vsnlogger/async.h"
+
+#include <spdlog/details/log_msg.h>
+#include <spdlog/formatter.h>
+#include <spdlog/sinks/sink.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+#include "vsnlogger/component.h"
+#include "vsnlogger/config.h"
+#include "vsnlogger/format.h"
+#include "vsnlogger/kv.h"
+
+namespace vsn {
+namespace logger {
+namespace async {
+
+/** Cache line size used to keep producer and writer ring state apart */
+static constexpr std::size_t k_cacheLine = 64U;
+
+/** Maximum thread class name length */
+static constexpr std::size_t k_maxThreadClassName = 31U;
+
+/** Marker for a ring writer that is not copying a slot */
+static constexpr std::uint64_t k_notReading =
+    std::numeric_limits<std::uint64_t>::max();
+
+/** Idle writer wake-up period, bounds latency of a missed notification */
+static constexpr std::chrono::milliseconds k_idlePoll(1);
+
+/** Maximum records written per merge pass before housekeeping */
+static constexpr std::size_t k_mergeBatch = 256U;
+
+/** Decode buffer reserved per writer: longest message plus its prefix;
+ * only a format padding its text past that grows it, once */
+static constexpr std::size_t k_decodeBufferReserve =
+    k_maxMessageBuffer + k_maxComponentPrefix;
+
+/**
+ * @brief Single-producer ring owned by one logging thread
+ *
+ * @details
+ * The producer only advances m_tail, the writer only advances m_head. The
+ * exception is the drop-oldest policy, where the producer advances m_head
+ * itself with a compare-and-swap and then waits until the writer is no
+ * longer copying the slot it is about to overwrite (m_reading).
+ */
+struct ThreadRing_t {
+    explicit ThreadRing_t(std::size_t capacity)
+        : m_records(new AsyncRecord_t[capacity]),
+          m_mask(static_cast<std::uint64_t>(capacity) - 1U),
+          m_tail(0U),
+          m_active(false),
+          m_retired(false),
+          m_enqueued(0U),
+          m_droppedNewest(0U),
+          m_droppedOldest(0U),
+          m_droppedBelowLevel(0U),
+          m_blocked(0U),
+          m_head(0U),
+          m_reading(k_notReading),
+          m_done(0U),
+          m_hasStaged(false),
+          m_stagedSeq(0U) {}
+
+    /** Preallocated slots, capacity is a power of two */
+    const std::unique_ptr<AsyncRecord_t[]> m_records;
+    const std::uint64_t m_mask;
+
+    /** Producer side */
+    alignas(k_cacheLine) std::atomic<std::uint64_t> m_tail;
+    std::atomic<bool> m_active;  /**< Producer is inside an enqueue */
+    std::atomic<bool> m_retired; /**< Owning thread exited */
+    std::atomic<std::uint64_t> m_enqueued;
+    std::atomic<std::uint64_t> m_droppedNewest;
+    std::atomic<std::uint64_t> m_droppedOldest;
+    std::atomic<std::uint64_t> m_droppedBelowLevel;
+    std::atomic<std::uint64_t> m_blocked;
+
+    /** Writer side */
+    alignas(k_cacheLine) std::atomic<std::uint64_t> m_head;
+    std::atomic<std::uint64_t> m_reading; /**< Sequence being copied out */
+    std::atomic<std::uint64_t> m_done;    /**< Sequences below are written */
+    bool m_hasStaged;                     /**< m_staged holds a record */
+    std::uint64_t m_stagedSeq;            /**< Sequence of m_staged */
+    AsyncRecord_t m_staged;               /**< Oldest popped record */
+};
+
+/**
+ * @brief Per-thread link to the ring registered with the current backend
+ */
+struct ThreadRingHandle_t {
+    std::uint64_t m_backendId;
+    std::shared_ptr<ThreadRing_t> m_ring;
+
+    ~ThreadRingHandle_t(void) {
+        if (m_ring) {
+            /* The writer drains and releases the ring */
+            m_ring->m_retired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+/** Source of backend identities */
+static std::atomic<std::uint64_t> g_backendSequence(1U);
+
+/** Thread class of the calling thread */
+static thread_local char t_threadClass[k_maxThreadClassName + 1U] = "default";
+
+/** Ring of the calling thread */
+static thread_local ThreadRingHandle_t t_threadRing{0U, nullptr};
+
+/* Increment a counter that has a single writer, avoiding a locked add */
+static void BumpCounter(std::atomic<std::uint64_t>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1U,
+                  std::memory_order_relaxed);
+}
+
+/* Ring capacity for the calling thread's class, rounded to a power of two */
+static std::size_t ResolveRingCapacity(std::uint32_t defaultSize) {
+    const std::int32_t configured = LogConfig::GetInstance().GetInt32(
+        std::string("thread_class.") + t_threadClass, "ring_size",
+        static_cast<std::int32_t>(defaultSize));
+
+    const std::uint32_t requested = std::min(
+        std::max((configured > 0) ? static_cast<std::uint32_t>(configured)
+                                  : defaultSize,
+                 1U),
+        AsyncBackend::k_maxQueueSize);
+
+    std::size_t capacity = 1U;
+    while (capacity < requested) {
+        capacity <<= 1U;
+    }
+    return capacity;
+}
+
+/* Copy record header and the used part of the payload */
+void CopyRecord(const AsyncRecord_t& from, AsyncRecord_t& to) {
+    to.m_ticks = from.m_ticks;
+    to.m_source = from.m_source;
+    to.m_threadId = from.m_threadId;
+    to.m_level = from.m_level;
+    to.m_component = from.m_component;
+    to.m_suppressed = from.m_suppressed;
+    to.m_decode = from.m_decode;
+    to.m_format = from.m_format;
+    to.m_size = from.m_size;
+    if (from.m_size > 0U) {
+        std::memcpy(to.m_payload, from.m_payload, from.m_size);
+    }
+}
+
+/* Pop the oldest record of a ring into its staging slot */
+static bool StageNext(ThreadRing_t& ring) {
+    while (true) {
+        const std::uint64_t head = ring.m_head.load(std::memory_order_acquire);
+        if (head == ring.m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        /* Announce the copy, then confirm the producer did not reclaim it */
+        ring.m_reading.store(head, std::memory_order_seq_cst);
+        if (ring.m_head.load(std::memory_order_seq_cst) != head) {
+            ring.m_reading.store(k_notReading, std::memory_order_release);
+            continue;
+        }
+
+        CopyRecord(ring.m_records[head & ring.m_mask], ring.m_staged);
+
+        std::uint64_t expected = head;
+        const bool popped = ring.m_head.compare_exchange_strong(
+            expected, head + 1U, std::memory_order_seq_cst);
+        ring.m_reading.store(k_notReading, std::memory_order_release);
+
+        if (popped) {
+            /* Merging compares wall time: rings mix TSC ticks with the
+             * nanosecond ticks of records formatted before queuing */
+            ring.m_staged.m_ticks =
+                logger::detail::ClockTicksToNanos(ring.m_staged.m_ticks);
+            ring.m_hasStaged = true;
+            ring.m_stagedSeq = head;
+            return true;
+        }
+        /* Overwritten under drop_oldest while copying, discard the copy */
+    }
+}
+
+/* True if the ring holds no record and no producer is enqueueing */
+static bool IsRingIdle(const ThreadRing_t& ring) {
+    return !ring.m_hasStaged &&
+           !ring.m_active.load(std::memory_order_seq_cst) &&
+           (ring.m_head.load(std::memory_order_acquire) ==
+            ring.m_tail.load(std::memory_order_acquire));
+}
+
+AsyncOptions_t GetDefaultOptions(void) {
+    return AsyncOptions_t{false, 8192U, 1U,    E_OverflowPolicy::E_BLOCK,
+                          E_LogLevel::E_WARN, false, false, 1024U};
+}
+
+E_Result ParseOverflowPolicy(const std::string& name,
+                             E_OverflowPolicy& policy) {
+    if (name == "block") {
+        policy = E_OverflowPolicy::E_BLOCK;
+    } else if (name == "drop_newest") {
+        policy = E_OverflowPolicy::E_DROP_NEWEST;
+    } else if (name == "drop_oldest") {
+        policy = E_OverflowPolicy::E_DROP_OLDEST;
+    } else if (name == "drop_below_level") {
+        policy = E_OverflowPolicy::E_DROP_BELOW_LEVEL;
+    } else {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    return E_Result::E_SUCCESS;
+}
+
+E_Result SetThreadClass(const std::string& name) {
+    if (name.empty()) {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    const std::size_t length = std::min(name.size(), k_maxThreadClassName);
+    std::memcpy(t_threadClass, name.data(), length);
+    t_threadClass[length] = '\0';
+
+    return E_Result::E_SUCCESS;
+}
+
+AsyncBackend::AsyncBackend(
+    const std::string& loggerName,
+    std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks,
+    const AsyncOptions_t& options)
+    : m_loggerName(loggerName),
+      m_sinks(std::move(sinks)),
+      m_options(options),
+      m_records(nullptr),
+      m_capacity(0U),
+      m_head(0U),
+      m_count(0U),
+      m_inFlight(0U),
+      m_running(false),
+      m_id(g_backendSequence.fetch_add(1U, std::memory_order_relaxed)),
+      m_ringsVersion(0U),
+      m_writerIdle(false),
+      m_flushWaiters(0U),
+      m_maxMessageLength(static_cast<std::uint32_t>(k_maxMessageBuffer)),
+      m_enqueued(0U),
+      m_droppedNewest(0U),
+      m_droppedOldest(0U),
+      m_droppedBelowLevel(0U),
+      m_blocked(0U) {
+    if (options.m_perThreadQueues) {
+        /* Rings are allocated by each producing thread */
+        return;
+    }
+
+    /* Clamp queue size to sane bounds */
+    m_capacity = std::min(std::max(options.m_queueSize, 1U), k_maxQueueSize);
+
+    /* Single up-front allocation for the whole queue */
+    m_records.reset(new AsyncRecord_t[m_capacity]);
+}
+
+AsyncBackend::~AsyncBackend(void) { static_cast<void>(Stop()); }
+
+E_Result AsyncBackend::Start(void) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_running) {
+        return E_Result::E_INVALID_STATE;
+    }
+
+    try {
+        const std::uint8_t threadCount = std::min(
+            std::max(m_options.m_workerThreads, static_cast<std::uint8_t>(1U)),
+            k_maxWorkerThreads);
+
+        m_running = true;
+        if (m_options.m_perThreadQueues) {
+            /* A single writer keeps the merged output in timestamp order */
+            m_workers.emplace_back(&AsyncBackend::MergeLoop, this);
+        } else {
+            for (std::uint8_t i = 0U; i < threadCount; ++i) {
+                m_workers.emplace_back(&AsyncBackend::WorkerLoop, this);
+            }
+        }
+
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        /* Keep whatever threads started; they exit on Stop() */
+        if (m_workers.empty()) {
+            m_running = false;
+            return E_Result::E_RESOURCE_UNAVAILABLE;
+        }
+        return E_Result::E_SUCCESS;
+    }
+}
+
+E_Result AsyncBackend::Stop(void) {
+    std::vector<std::thread> workers;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return E_Result::E_SUCCESS;
+        }
+
+        /* Writers drain the queue before observing the stop request */
+        m_running = false;
+        workers.swap(m_workers);
+    }
+
+    m_notEmpty.notify_all();
+    m_notFull.notify_all();
+    m_drained.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    try {
+        for (const auto& sink : m_sinks) {
+            sink->flush();
+        }
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_Result AsyncBackend::Enqueue(const spdlog::details::log_msg& msg) {
+    /* Stage the formatted payload, truncating what does not fit */
+    AsyncRecord_t record;
+    std::size_t payloadSize = std::min(msg.payload.size(), k_maxRecordPayload);
+
+    record.m_ticks = logger::detail::TimeToClockTicks(msg.time);
+    record.m_source = msg.source;
+    record.m_threadId = msg.thread_id;
+    record.m_level = msg.level;
+    record.m_component = nullptr;
+    record.m_suppressed = 0U;
+    record.m_decode = nullptr;
+    record.m_format = nullptr;
+    if (payloadSize > 0U) {
+        std::memcpy(record.m_payload, msg.payload.data(), payloadSize);
+    }
+    if (msg.payload.size() > k_maxRecordPayload) {
+        payloadSize = logger::detail::MarkTruncated(
+            reinterpret_cast<char*>(record.m_payload), k_maxRecordPayload);
+    }
+    record.m_size = static_cast<std::uint16_t>(payloadSize);
+
+    return Enqueue(record);
+}
+
+E_Result AsyncBackend::Enqueue(const AsyncRecord_t& record) {
+    if (m_options.m_perThreadQueues) {
+        return PushThreadRing(record);
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (!m_running) {
+        /* Backend stopped: write on the calling thread instead of dropping */
+        lock.unlock();
+        spdlog::memory_buf_t scratch;
+        return Dispatch(record, scratch);
+    }
+
+    if (m_count == m_capacity) {
+        switch (m_options.m_overflowPolicy) {
+            case E_OverflowPolicy::E_DROP_NEWEST:
+                m_droppedNewest.fetch_add(1U, std::memory_order_relaxed);
+                return E_Result::E_RESOURCE_UNAVAILABLE;
+
+            case E_OverflowPolicy::E_DROP_OLDEST:
+                /* Release the oldest slot for the incoming record */
+                m_head = (m_head + 1U) % m_capacity;
+                --m_count;
+                m_droppedOldest.fetch_add(1U, std::memory_order_relaxed);
+                break;
+
+            case E_OverflowPolicy::E_DROP_BELOW_LEVEL:
+                if (static_cast<int>(record.m_level) <
+                    static_cast<int>(m_options.m_dropBelowLevel)) {
+                    m_droppedBelowLevel.fetch_add(1U,
+                                                  std::memory_order_relaxed);
+                    return E_Result::E_RESOURCE_UNAVAILABLE;
+                }
+                /* Records at or above the threshold wait for space */
+                m_blocked.fetch_add(1U, std::memory_order_relaxed);
+                m_notFull.wait(lock, [this]() {
+                    return (m_count < m_capacity) || !m_running;
+                });
+                break;
+
+            case E_OverflowPolicy::E_BLOCK:
+            default:
+                m_blocked.fetch_add(1U, std::memory_order_relaxed);
+                m_notFull.wait(lock, [this]() {
+                    return (m_count < m_capacity) || !m_running;
+                });
+                break;
+        }
+
+        if (!m_running) {
+            /* Woken by Stop() while waiting for space */
+            lock.unlock();
+            spdlog::memory_buf_t scratch;
+            return Dispatch(record, scratch);
+        }
+    }
+
+    /* Copy the record into the next free slot */
+    CopyRecord(record, m_records[(m_head + m_count) % m_capacity]);
+
+    ++m_count;
+    m_enqueued.fetch_add(1U, std::memory_order_relaxed);
+
+    lock.unlock();
+    m_notEmpty.notify_one();
+
+    return E_Result::E_SUCCESS;
+}
+
+E_Result AsyncBackend::Flush(void) {
+    if (m_options.m_perThreadQueues) {
+        /* Wait until every record published so far has been written */
+        std::vector<std::pair<std::shared_ptr<ThreadRing_t>, std::uint64_t>>
+            targets;
+        try {
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            targets.reserve(m_rings.size());
+            for (const auto& ring : m_rings) {
+                targets.emplace_back(
+                    ring, ring->m_tail.load(std::memory_order_acquire));
+            }
+        } catch (...) {
+            return E_Result::E_RESOURCE_UNAVAILABLE;
+        }
+
+        m_flushWaiters.fetch_add(1U, std::memory_order_seq_cst);
+        m_notEmpty.notify_one();
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_drained.wait(lock, [this, &targets]() {
+                if (!m_running) {
+                    return true;
+                }
+                for (const auto& target : targets) {
+                    if (target.first->m_done.load(std::memory_order_acquire) <
+                        target.second) {
+                        return false;
+                    }
+                }
+                return true;
+            });
+        }
+        m_flushWaiters.fetch_sub(1U, std::memory_order_relaxed);
+    } else {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_drained.wait(lock, [this]() {
+            return ((0U == m_count) && (0U == m_inFlight)) || !m_running;
+        });
+    }
+
+    try {
+        for (const auto& sink : m_sinks) {
+            sink->flush();
+        }
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_Result AsyncBackend::PrepareThread(void) {
+    if (!m_options.m_perThreadQueues) {
+        return E_Result::E_SUCCESS;
+    }
+
+    return (nullptr != AcquireThreadRing()) ? E_Result::E_SUCCESS
+                                            : E_Result::E_ALLOCATION_FAILED;
+}
+
+void AsyncBackend::SetMaxMessageLength(std::uint32_t length) {
+    m_maxMessageLength.store(length, std::memory_order_relaxed);
+}
+
+void AsyncBackend::SetFormatter(const spdlog::formatter& formatter) {
+    for (const auto& sink : m_sinks) {
+        sink->set_formatter(formatter.clone());
+    }
+}
+
+AsyncStats_t AsyncBackend::GetStats(void) const {
+    /* Rings are folded into the backend counters under the same lock */
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+
+    AsyncStats_t stats{m_enqueued.load(std::memory_order_relaxed),
+                       m_droppedNewest.load(std::memory_order_relaxed),
+                       m_droppedOldest.load(std::memory_order_relaxed),
+                       m_droppedBelowLevel.load(std::memory_order_relaxed),
+                       m_blocked.load(std::memory_order_relaxed)};
+
+    for (const auto& ring : m_rings) {
+        stats.m_enqueued += ring->m_enqueued.load(std::memory_order_relaxed);
+        stats.m_droppedNewest +=
+            ring->m_droppedNewest.load(std::memory_order_relaxed);
+        stats.m_droppedOldest +=
+            ring->m_droppedOldest.load(std::memory_order_relaxed);
+        stats.m_droppedBelowLevel +=
+            ring->m_droppedBelowLevel.load(std::memory_order_relaxed);
+        stats.m_blocked += ring->m_blocked.load(std::memory_order_relaxed);
+    }
+
+    return stats;
+}
+
+ThreadRing_t* AsyncBackend::AcquireThreadRing(void) {
+    if ((t_threadRing.m_backendId == m_id) && t_threadRing.m_ring) {
+        return t_threadRing.m_ring.get();
+    }
+
+    try {
+        auto ring = std::make_shared<ThreadRing_t>(
+            ResolveRingCapacity(m_options.m_ringSize));
+
+        {
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            m_rings.push_back(ring);
+            m_ringsVersion.fetch_add(1U, std::memory_order_release);
+        }
+
+        /* Ring of a replaced backend is drained by its own writer */
+        if (t_threadRing.m_ring) {
+            t_threadRing.m_ring->m_retired.store(true,
+                                                 std::memory_order_release);
+        }
+        t_threadRing.m_ring = std::move(ring);
+        t_threadRing.m_backendId = m_id;
+
+        return t_threadRing.m_ring.get();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+E_Result AsyncBackend::PushThreadRing(const AsyncRecord_t& record) {
+    ThreadRing_t* const ring = AcquireThreadRing();
+    if (nullptr == ring) {
+        spdlog::memory_buf_t scratch;
+        return Dispatch(record, scratch);
+    }
+
+    /* Pairs with the writer's exit check: either it sees us or we see Stop */
+    ring->m_active.store(true, std::memory_order_seq_cst);
+    if (!m_running.load(std::memory_order_seq_cst)) {
+        ring->m_active.store(false, std::memory_order_release);
+        spdlog::memory_buf_t scratch;
+        return Dispatch(record, scratch);
+    }
+
+    const std::uint64_t tail = ring->m_tail.load(std::memory_order_relaxed);
+    const std::uint64_t capacity = ring->m_mask + 1U;
+    const E_OverflowPolicy policy = m_options.m_overflowPolicy;
+    bool waited = false;
+
+    while ((tail - ring->m_head.load(std::memory_order_acquire)) >= capacity) {
+        if ((E_OverflowPolicy::E_DROP_NEWEST == policy) ||
+            ((E_OverflowPolicy::E_DROP_BELOW_LEVEL == policy) &&
+             (static_cast<int>(record.m_level) <
+              static_cast<int>(m_options.m_dropBelowLevel)))) {
+            BumpCounter((E_OverflowPolicy::E_DROP_NEWEST == policy)
+                            ? ring->m_droppedNewest
+                            : ring->m_droppedBelowLevel);
+            ring->m_active.store(false, std::memory_order_release);
+            return E_Result::E_RESOURCE_UNAVAILABLE;
+        }
+
+        if (E_OverflowPolicy::E_DROP_OLDEST == policy) {
+            /* Reclaim the oldest slot unless the writer popped it meanwhile */
+            std::uint64_t oldest = tail - capacity;
+            if (ring->m_head.compare_exchange_strong(
+                    oldest, oldest + 1U, std::memory_order_seq_cst)) {
+                BumpCounter(ring->m_droppedOldest);
+                while (ring->m_reading.load(std::memory_order_seq_cst) ==
+                       tail - capacity) {
+                    std::this_thread::yield();
+                }
+            }
+            continue;
+        }
+
+        /* Block, and drop_below_level for records at or above the level */
+        if (!waited) {
+            BumpCounter(ring->m_blocked);
+            waited = true;
+        }
+        std::this_thread::yield();
+    }
+
+    CopyRecord(record, ring->m_records[tail & ring->m_mask]);
+    ring->m_tail.store(tail + 1U, std::memory_order_release);
+    BumpCounter(ring->m_enqueued);
+    ring->m_active.store(false, std::memory_order_release);
+
+    if (m_writerIdle.load(std::memory_order_relaxed)) {
+        m_notEmpty.notify_one();
+    }
+
+    return E_Result::E_SUCCESS;
+}
+
+void AsyncBackend::WorkerLoop(void) {
+    /* Record copy and decode buffer owned by this writer, reused per pop */
+    std::unique_ptr<AsyncRecord_t> local(new AsyncRecord_t());
+    spdlog::memory_buf_t scratch;
+    scratch.reserve(k_decodeBufferReserve);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        m_notEmpty.wait(lock, [this]() { return (m_count > 0U) || !m_running; });
+
+        if (0U == m_count) {
+            /* Stop requested and queue drained */
+            break;
+        }
+
+        /* Pop the oldest record */
+        CopyRecord(m_records[m_head], *local);
+
+        m_head = (m_head + 1U) % m_capacity;
+        --m_count;
+        ++m_inFlight;
+
+        lock.unlock();
+        m_notFull.notify_one();
+
+        static_cast<void>(Dispatch(*local, scratch));
+
+        lock.lock();
+        --m_inFlight;
+        if ((0U == m_count) && (0U == m_inFlight)) {
+            m_drained.notify_all();
+        }
+    }
+
+    m_drained.notify_all();
+}
+
+void AsyncBackend::MergeLoop(void) {
+    std::vector<std::shared_ptr<ThreadRing_t>> rings;
+    std::uint64_t ringsVersion = std::numeric_limits<std::uint64_t>::max();
+    spdlog::memory_buf_t scratch;
+    scratch.reserve(k_decodeBufferReserve);
+
+    while (true) {
+        const bool running = m_running.load(std::memory_order_seq_cst);
+
+        /* Refresh the ring snapshot, always before deciding to exit */
+        if (!running || (m_ringsVersion.load(std::memory_order_acquire) !=
+                         ringsVersion)) {
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            rings = m_rings;
+            ringsVersion = m_ringsVersion.load(std::memory_order_relaxed);
+        }
+
+        const std::size_t written = MergeRings(rings, scratch);
+
+        if ((written > 0U) &&
+            (m_flushWaiters.load(std::memory_order_seq_cst) > 0U)) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_drained.notify_all();
+        }
+
+        if (written > 0U) {
+            continue;
+        }
+
+        ReleaseRetiredRings(rings);
+
+        if (!running && std::all_of(rings.begin(), rings.end(),
+                                    [](const std::shared_ptr<ThreadRing_t>&
+                                           ring) { return IsRingIdle(*ring); })) {
+            /* Stop requested, all rings drained and no producer mid-enqueue */
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_flushWaiters.load(std::memory_order_seq_cst) > 0U) {
+            m_drained.notify_all();
+        }
+        m_writerIdle.store(true, std::memory_order_seq_cst);
+        m_notEmpty.wait_for(lock, k_idlePoll, [this, &rings, ringsVersion]() {
+            return !m_running ||
+                   (m_ringsVersion.load(std::memory_order_acquire) !=
+                    ringsVersion) ||
+                   std::any_of(rings.begin(), rings.end(),
+                               [](const std::shared_ptr<ThreadRing_t>& ring) {
+                                   return ring->m_head.load(
+                                              std::memory_order_acquire) !=
+                                          ring->m_tail.load(
+                                              std::memory_order_acquire);
+                               });
+        });
+        m_writerIdle.store(false, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_drained.notify_all();
+}
+
+std::size_t AsyncBackend::MergeRings(
+    std::vector<std::shared_ptr<ThreadRing_t>>& rings,
+    spdlog::memory_buf_t& scratch) {
+    std::size_t written = 0U;
+
+    while (written < k_mergeBatch) {
+        /* Stage the oldest record of every ring, pick the earliest */
+        ThreadRing_t* earliest = nullptr;
+        for (const auto& ring : rings) {
+            if (!ring->m_hasStaged && !StageNext(*ring)) {
+                continue;
+            }
+            if ((nullptr == earliest) ||
+                (ring->m_staged.m_ticks < earliest->m_staged.m_ticks)) {
+                earliest = ring.get();
+            }
+        }
+
+        if (nullptr == earliest) {
+            break;
+        }
+
+        static_cast<void>(Dispatch(earliest->m_staged, scratch));
+        earliest->m_hasStaged = false;
+        earliest->m_done.store(earliest->m_stagedSeq + 1U,
+                               std::memory_order_release);
+        ++written;
+    }
+
+    return written;
+}
+
+void AsyncBackend::ReleaseRetiredRings(
+    std::vector<std::shared_ptr<ThreadRing_t>>& rings) {
+    const auto isReleasable = [](const std::shared_ptr<ThreadRing_t>& ring) {
+        return ring->m_retired.load(std::memory_order_acquire) &&
+               IsRingIdle(*ring);
+    };
+
+    if (std::none_of(rings.begin(), rings.end(), isReleasable)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_ringsMutex);
+    for (const auto& ring : rings) {
+        if (!isReleasable(ring)) {
+            continue;
+        }
+
+        /* Keep the counters of the exited thread */
+        m_enqueued.fetch_add(ring->m_enqueued.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+        m_droppedNewest.fetch_add(
+            ring->m_droppedNewest.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        m_droppedOldest.fetch_add(
+            ring->m_droppedOldest.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        m_droppedBelowLevel.fetch_add(
+            ring->m_droppedBelowLevel.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        m_blocked.fetch_add(ring->m_blocked.load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
+
+        m_rings.erase(std::remove(m_rings.begin(), m_rings.end(), ring),
+                      m_rings.end());
+    }
+    m_ringsVersion.fetch_add(1U, std::memory_order_release);
+    rings = m_rings;
+}
+
+spdlog::string_view_t RenderRecord(const AsyncRecord_t& record,
+                                   std::size_t limit,
+                                   spdlog::memory_buf_t& scratch) {
+    if (nullptr == record.m_decode) {
+        return spdlog::string_view_t(
+            reinterpret_cast<const char*>(record.m_payload), record.m_size);
+    }
+
+    /* Deferred record: run the format string on this thread */
+    scratch.clear();
+    if (nullptr != record.m_component) {
+        const char* const prefix = record.m_component->m_prefix;
+        scratch.append(prefix, prefix + record.m_component->m_prefixLength);
+    }
+    const std::size_t prefixSize = scratch.size();
+    try {
+        record.m_decode(record.m_format, record.m_payload, scratch);
+    } catch (...) {
+        /* Emit the raw format string rather than losing the record */
+        scratch.resize(prefixSize);
+        if (nullptr != record.m_format) {
+            const spdlog::string_view_t format(record.m_format);
+            scratch.append(format.data(), format.data() + format.size());
+        }
+    }
+
+    if (scratch.size() > limit) {
+        scratch.resize(logger::detail::MarkTruncated(scratch.data(), limit));
+    }
+    if (record.m_suppressed > 0U) {
+        const std::size_t size = scratch.size();
+        scratch.resize(std::max(size, limit));
+        scratch.resize(logger::detail::AppendSuppressed(
+            scratch.data(), size, limit, record.m_suppressed));
+    }
+    return spdlog::string_view_t(scratch.data(), scratch.size());
+}
+
+E_Result AsyncBackend::Dispatch(const AsyncRecord_t& record,
+                                spdlog::memory_buf_t& scratch) {
+    const spdlog::string_view_t payload = RenderRecord(
+        record, m_maxMessageLength.load(std::memory_order_relaxed), scratch);
+
+    spdlog::details::log_msg msg(
+        logger::detail::ClockTicksToTime(record.m_ticks), record.m_source,
+        m_loggerName, record.m_level, payload);
+    msg.thread_id = record.m_threadId;
+
+    /* Typed fields of a structured record, read by the formatters */
+    logger::detail::KvContext_t context;
+    const logger::detail::KvScope_t scope(
+        logger::detail::BindKvContext(record, payload.data(), context));
+
+    E_Result result = E_Result::E_SUCCESS;
+    for (const auto& sink : m_sinks) {
+        try {
+            if (sink->should_log(msg.level)) {
+                sink->log(msg);
+            }
+        } catch (...) {
+            /* A failing sink must not stop the other sinks or the writer */
+            result = E_Result::E_UNKNOWN_ERROR;
+        }
+    }
+
+    return result;
+}
+
+} /* namespace async */
+} /* namespace logger */
+} /* namespace vsn */
@@ -0,0 +1,298 @@
+/**
+ * @file clock.cpp
+ * @brief Implementation of the timestamp sources for VSNLogger
+ *
+ * @details
+ * The TSC mapping is an anchor (cycles, nanoseconds) and a rate, published
+ * under a sequence lock so converting threads never block. Every second
+ * the calibration thread samples the counter against the system clock,
+ * measures the rate over the elapsed interval and moves the anchor to the
+ * new sample, which bounds accumulated drift to one interval's rate error.
+ * An interval whose rate is off by more than 0.1 percent saw the wall
+ * clock stepped; it only moves the anchor and keeps the previous rate.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include "vsnlogger/clock.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if VSN_HAS_TSC
+#include <cpuid.h>
+#endif
+
+namespace vsn {
+namespace logger {
+
+namespace detail {
+
+std::atomic<E_ClockSource> g_clockSource(E_ClockSource::E_SYSTEM);
+
+} /* namespace detail */
+
+/**
+ * @brief Counter value read together with the system clock
+ */
+struct TscSample_t {
+    std::uint64_t m_cycles;
+    std::uint64_t m_nanos;
+};
+
+/* Samples per calibration point, the tightest one is kept */
+static constexpr std::uint32_t k_tscSampleTries = 8U;
+
+/* Interval of the initial calibration */
+static constexpr std::uint32_t k_tscInitialMs = 20U;
+
+/* Relative rate change taken as a wall clock step */
+static constexpr double k_tscMaxRateChange = 1e-3;
+
+/* Cycle to wall time mapping, odd sequence while being written */
+static std::atomic<std::uint32_t> g_tscSequence(0U);
+static std::atomic<std::uint64_t> g_tscBaseCycles(0U);
+static std::atomic<std::uint64_t> g_tscBaseNanos(0U);
+static std::atomic<double> g_tscNanosPerCycle(0.0);
+
+/* Serializes source changes */
+static std::mutex g_clockMutex;
+
+#if VSN_HAS_TSC
+
+/* True if the counter runs at a constant rate in every power state */
+static bool HasInvariantTsc(void) {
+    unsigned int eax = 0U;
+    unsigned int ebx = 0U;
+    unsigned int ecx = 0U;
+    unsigned int edx = 0U;
+    if ((0 == __get_cpuid(0x80000000U, &eax, &ebx, &ecx, &edx)) ||
+        (eax < 0x80000007U)) {
+        return false;
+    }
+    if (0 == __get_cpuid(0x80000007U, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return 0U != (edx & (1U << 8U));
+}
+
+/* Read the system clock between two counter reads, keep the tightest */
+static TscSample_t SampleTsc(void) {
+    TscSample_t best{0U, 0U};
+    std::uint64_t bestSpread = ~static_cast<std::uint64_t>(0U);
+
+    for (std::uint32_t i = 0U; i < k_tscSampleTries; ++i) {
+        const std::uint64_t before = __rdtsc();
+        const std::uint64_t nanos = detail::SystemTicks();
+        const std::uint64_t after = __rdtsc();
+        if ((after - before) < bestSpread) {
+            bestSpread = after - before;
+            best.m_cycles = before + ((after - before) / 2U);
+            best.m_nanos = nanos;
+        }
+    }
+    return best;
+}
+
+#endif
+
+/* Publish a new mapping */
+static void PublishTsc(const TscSample_t& anchor, double nanosPerCycle) {
+    const std::uint32_t sequence =
+        g_tscSequence.load(std::memory_order_relaxed);
+    g_tscSequence.store(sequence + 1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    g_tscBaseCycles.store(anchor.m_cycles, std::memory_order_relaxed);
+    g_tscBaseNanos.store(anchor.m_nanos, std::memory_order_relaxed);
+    g_tscNanosPerCycle.store(nanosPerCycle, std::memory_order_relaxed);
+
+    g_tscSequence.store(sequence + 2U, std::memory_order_release);
+}
+
+/* Nanoseconds per cycle between two samples, 0 if unusable */
+static double MeasureRate(const TscSample_t& from, const TscSample_t& to) {
+    if ((to.m_cycles <= from.m_cycles) || (to.m_nanos <= from.m_nanos)) {
+        return 0.0;
+    }
+    return static_cast<double>(to.m_nanos - from.m_nanos) /
+           static_cast<double>(to.m_cycles - from.m_cycles);
+}
+
+/**
+ * @brief Owner of the calibration thread
+ */
+class TscCalibrator {
+   public:
+    TscCalibrator(void) : m_running(false), m_stop(false) {}
+    ~TscCalibrator(void) { Stop(); }
+
+    TscCalibrator(const TscCalibrator&) = delete;
+    TscCalibrator& operator=(const TscCalibrator&) = delete;
+
+    /* Calibrate and start the thread, caller holds g_clockMutex */
+    E_Result Start(void);
+
+    /* Stop the thread, caller holds g_clockMutex or is exiting */
+    void Stop(void);
+
+   private:
+    void Run(TscSample_t anchor, double nanosPerCycle);
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_running;
+    bool m_stop;
+};
+
+static TscCalibrator g_tscCalibrator;
+
+E_Result TscCalibrator::Start(void) {
+#if VSN_HAS_TSC
+    if (m_running) {
+        return E_Result::E_SUCCESS;
+    }
+    if (!HasInvariantTsc()) {
+        return E_Result::E_RESOURCE_UNAVAILABLE;
+    }
+
+    const TscSample_t first = SampleTsc();
+    std::this_thread::sleep_for(std::chrono::milliseconds(k_tscInitialMs));
+    const TscSample_t second = SampleTsc();
+    const double nanosPerCycle = MeasureRate(first, second);
+    if (nanosPerCycle <= 0.0) {
+        return E_Result::E_RESOURCE_UNAVAILABLE;
+    }
+    PublishTsc(second, nanosPerCycle);
+
+    m_stop = false;
+    m_thread = std::thread(&TscCalibrator::Run, this, second, nanosPerCycle);
+    m_running = true;
+    return E_Result::E_SUCCESS;
+#else
+    return E_Result::E_RESOURCE_UNAVAILABLE;
+#endif
+}
+
+void TscCalibrator::Stop(void) {
+    if (!m_running) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+    m_running = false;
+}
+
+void TscCalibrator::Run(TscSample_t anchor, double nanosPerCycle) {
+#if VSN_HAS_TSC
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_wake.wait_for(lock,
+                            std::chrono::milliseconds(k_clockCalibrationMs),
+                            [this] { return m_stop; })) {
+        const TscSample_t sample = SampleTsc();
+        const double measured = MeasureRate(anchor, sample);
+        const double change = (measured - nanosPerCycle) / nanosPerCycle;
+        if ((change < k_tscMaxRateChange) && (change > -k_tscMaxRateChange)) {
+            nanosPerCycle = measured;
+        }
+        PublishTsc(sample, nanosPerCycle);
+        anchor = sample;
+    }
+#else
+    static_cast<void>(anchor);
+    static_cast<void>(nanosPerCycle);
+#endif
+}
+
+namespace detail {
+
+std::uint64_t TscToNanos(std::uint64_t cycles) {
+    std::uint32_t sequence = 0U;
+    std::uint64_t baseCycles = 0U;
+    std::uint64_t baseNanos = 0U;
+    double nanosPerCycle = 0.0;
+
+    do {
+        sequence = g_tscSequence.load(std::memory_order_acquire);
+        baseCycles = g_tscBaseCycles.load(std::memory_order_relaxed);
+        baseNanos = g_tscBaseNanos.load(std::memory_order_relaxed);
+        nanosPerCycle = g_tscNanosPerCycle.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((0U != (sequence & 1U)) ||
+             (sequence != g_tscSequence.load(std::memory_order_relaxed)));
+
+    /* Cycles taken before the anchor give a negative offset */
+    const double offset =
+        static_cast<double>(static_cast<std::int64_t>(cycles - baseCycles)) *
+        nanosPerCycle;
+    return baseNanos +
+           static_cast<std::uint64_t>(static_cast<std::int64_t>(offset));
+}
+
+} /* namespace detail */
+
+E_Result SetClockSource(E_ClockSource source) {
+    try {
+        std::lock_guard<std::mutex> lock(g_clockMutex);
+
+        switch (source) {
+            case E_ClockSource::E_SYSTEM:
+                break;
+            case E_ClockSource::E_COARSE:
+#ifdef CLOCK_REALTIME_COARSE
+                break;
+#else
+                return E_Result::E_RESOURCE_UNAVAILABLE;
+#endif
+            case E_ClockSource::E_TSC: {
+                const E_Result result = g_tscCalibrator.Start();
+                if (E_Result::E_SUCCESS != result) {
+                    return result;
+                }
+                break;
+            }
+            default:
+                return E_Result::E_INVALID_PARAMETER;
+        }
+
+        detail::g_clockSource.store(source, std::memory_order_release);
+
+        /* TSC ticks still queued convert under the last calibration */
+        if (E_ClockSource::E_TSC != source) {
+            g_tscCalibrator.Stop();
+        }
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_ClockSource GetClockSource(void) {
+    return detail::g_clockSource.load(std::memory_order_relaxed);
+}
+
+E_Result ParseClockSource(const std::string& name, E_ClockSource& source) {
+    if (name == "system") {
+        source = E_ClockSource::E_SYSTEM;
+    } else if (name == "coarse") {
+        source = E_ClockSource::E_COARSE;
+    } else if (name == "tsc") {
+        source = E_ClockSource::E_TSC;
+    } else {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    return E_Result::E_SUCCESS;
+}
+
+} /* namespace logger */
+} /* namespace vsn */
@@ -0,0 +1,271 @@
+/**
+ * @file component.cpp
+ * @brief Implementation of the component table for VSNLogger
+ *
+ * @details
+ * The table is a fixed array with static storage, so interning never
+ * allocates. Entry 0 stands for records without a component and collects
+ * the records of components interned after the table filled up. Entries
+ * are published by bumping the entry count with release ordering after
+ * the name is written, so readers need no lock.
+ *
+ * Level rules live in a second fixed table. Every change to the rules or
+ * to the default level re-resolves the level of all interned components
+ * under the interning mutex; loggers only ever read the resolved levels.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include "vsnlogger/component.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "vsnlogger/logger.h"
+
+namespace vsn {
+namespace logger {
+
+namespace detail {
+
+std::atomic<std::uint8_t> g_componentLevels[k_maxComponents];
+
+} /* namespace detail */
+
+/**
+ * @brief One interned component
+ */
+struct ComponentEntry_t {
+    char m_name[k_maxComponentPrefix]; /**< Null-terminated name */
+    std::atomic<std::uint64_t> m_records[k_componentLevelCount];
+};
+
+/**
+ * @brief Minimum level configured for a component subtree
+ */
+struct ComponentRule_t {
+    char m_name[k_maxComponentPrefix]; /**< Null-terminated name */
+    std::uint8_t m_level;              /**< Minimum severity */
+};
+
+/* Serializes interning and level changes */
+static std::mutex g_componentMutex;
+
+/* Interned components, entry 0 is the default entry */
+static ComponentEntry_t g_components[k_maxComponents];
+
+/* Number of published entries */
+static std::atomic<std::uint32_t> g_componentCount(0U);
+
+/* Configured level rules, guarded by g_componentMutex */
+static ComponentRule_t g_componentRules[k_maxComponentRules];
+static std::uint32_t g_componentRuleCount = 0U;
+
+/* Level of components without a rule, guarded by g_componentMutex */
+static std::uint8_t g_defaultLevel = 0U;
+
+/* Copy a name into a buffer, cutting it to the buffer size */
+static void SetEntryName(char (&buffer)[k_maxComponentPrefix],
+                         const char* name) {
+    std::size_t length = 0U;
+    if (nullptr != name) {
+        length = std::min(std::strlen(name), sizeof(buffer) - 1U);
+        std::memcpy(buffer, name, length);
+    }
+    buffer[length] = '\0';
+}
+
+/* Rule name equals the component name or is one of its ancestors */
+static bool RuleCovers(const char* rule, const char* name) {
+    const std::size_t length = std::strlen(rule);
+    return (0 == std::strncmp(rule, name, length)) &&
+           (('\0' == name[length]) || ('.' == name[length]));
+}
+
+/* Level of the most specific rule covering a name, caller holds the mutex */
+static std::uint8_t ResolveLevel(const char* name) {
+    std::uint8_t level = g_defaultLevel;
+    std::size_t matched = 0U;
+
+    for (std::uint32_t i = 0U; i < g_componentRuleCount; ++i) {
+        const ComponentRule_t& rule = g_componentRules[i];
+        const std::size_t length = std::strlen(rule.m_name);
+        if ((length >= matched) && RuleCovers(rule.m_name, name)) {
+            level = rule.m_level;
+            matched = length;
+        }
+    }
+
+    return level;
+}
+
+/* Re-resolve every interned level, caller holds the mutex */
+static void ApplyLevels(void) {
+    detail::g_componentLevels[k_defaultComponent].store(
+        g_defaultLevel, std::memory_order_relaxed);
+
+    const std::uint32_t count =
+        g_componentCount.load(std::memory_order_relaxed);
+    for (std::uint32_t i = 1U; i < count; ++i) {
+        detail::g_componentLevels[i].store(ResolveLevel(g_components[i].m_name),
+                                           std::memory_order_relaxed);
+    }
+}
+
+std::uint32_t InternComponent(Component_t& component) {
+    try {
+        std::lock_guard<std::mutex> lock(g_componentMutex);
+
+        std::uint32_t id = component.m_id.load(std::memory_order_relaxed);
+        if (k_unregisteredComponent != id) {
+            return id;
+        }
+
+        std::uint32_t count = g_componentCount.load(std::memory_order_relaxed);
+        if (0U == count) {
+            SetEntryName(g_components[k_defaultComponent].m_name, "(default)");
+            count = 1U;
+            g_componentCount.store(count, std::memory_order_release);
+        }
+
+        /* Same name, same ID */
+        char name[k_maxComponentPrefix];
+        SetEntryName(name, component.m_name);
+        id = k_defaultComponent;
+        for (std::uint32_t i = 1U; i < count; ++i) {
+            if (0 == std::strcmp(g_components[i].m_name, name)) {
+                id = i;
+                break;
+            }
+        }
+
+        if ((k_defaultComponent == id) && (count < k_maxComponents)) {
+            id = count;
+            SetEntryName(g_components[id].m_name, name);
+            detail::g_componentLevels[id].store(ResolveLevel(name),
+                                                std::memory_order_relaxed);
+            g_componentCount.store(count + 1U, std::memory_order_release);
+        }
+
+        component.m_id.store(id, std::memory_order_release);
+        return id;
+    } catch (...) {
+        return k_defaultComponent;
+    }
+}
+
+void CountComponentRecord(std::uint32_t id, E_LogLevel level) {
+    const std::size_t index = static_cast<std::size_t>(level);
+    if ((id < k_maxComponents) && (index < k_componentLevelCount)) {
+        g_components[id].m_records[index].fetch_add(1U,
+                                                    std::memory_order_relaxed);
+    }
+}
+
+/* Copy the counters of an entry */
+static void ReadStats(const ComponentEntry_t& entry, ComponentStats_t& stats) {
+    for (std::size_t i = 0U; i < k_componentLevelCount; ++i) {
+        stats.m_records[i] = entry.m_records[i].load(std::memory_order_relaxed);
+    }
+}
+
+E_Result GetComponentStats(Component_t& component, ComponentStats_t& stats) {
+    ReadStats(g_components[component.GetId()], stats);
+    return E_Result::E_SUCCESS;
+}
+
+E_Result EnumerateComponents(ComponentVisitor_t visitor, void* context) {
+    if (nullptr == visitor) {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    try {
+        const std::uint32_t count =
+            g_componentCount.load(std::memory_order_acquire);
+        for (std::uint32_t i = 0U; i < count; ++i) {
+            ComponentStats_t stats;
+            ReadStats(g_components[i], stats);
+            visitor(i, g_components[i].m_name, stats, context);
+        }
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_Result ConfigureComponentLevel(const char* name, E_LogLevel level) {
+    if ((nullptr == name) || ('\0' == name[0]) ||
+        (std::strlen(name) >= k_maxComponentPrefix) ||
+        (level > E_LogLevel::E_OFF)) {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    try {
+        std::lock_guard<std::mutex> lock(g_componentMutex);
+
+        std::uint32_t index = 0U;
+        while ((index < g_componentRuleCount) &&
+               (0 != std::strcmp(g_componentRules[index].m_name, name))) {
+            ++index;
+        }
+
+        if (index == g_componentRuleCount) {
+            if (g_componentRuleCount >= k_maxComponentRules) {
+                return E_Result::E_RESOURCE_UNAVAILABLE;
+            }
+            SetEntryName(g_componentRules[index].m_name, name);
+            ++g_componentRuleCount;
+        }
+
+        g_componentRules[index].m_level = static_cast<std::uint8_t>(level);
+        ApplyLevels();
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_Result ClearComponentLevels(void) {
+    try {
+        std::lock_guard<std::mutex> lock(g_componentMutex);
+        g_componentRuleCount = 0U;
+        ApplyLevels();
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_Result ConfigureDefaultLevel(E_LogLevel level) {
+    if (level > E_LogLevel::E_OFF) {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    try {
+        std::lock_guard<std::mutex> lock(g_componentMutex);
+        g_defaultLevel = static_cast<std::uint8_t>(level);
+        ApplyLevels();
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_LogLevel GetComponentLevelFloor(void) {
+    try {
+        std::lock_guard<std::mutex> lock(g_componentMutex);
+
+        std::uint8_t floor = g_defaultLevel;
+        for (std::uint32_t i = 0U; i < g_componentRuleCount; ++i) {
+            floor = std::min(floor, g_componentRules[i].m_level);
+        }
+        return static_cast<E_LogLevel>(floor);
+    } catch (...) {
+        return E_LogLevel::E_TRACE;
+    }
+}
+
+} /* namespace logger */
+} /* namespace vsn */
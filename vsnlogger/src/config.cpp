@@ -341,5 +341,48 @@ E_Result LogConfig::Set(const std::string& section, const std::string& key,
     return E_Result::E_SUCCESS;
 }
 
+E_Result LogConfig::GetSectionNames(const std::string& prefix,
+                                    std::vector<std::string>& sections) {
+    /* Thread synchronization for data access */
+    std::lock_guard<std::mutex> lock(g_configMutex);
+
+    try {
+        sections.clear();
+        for (auto it = m_configData.lower_bound(prefix);
+             it != m_configData.end() &&
+             0 == it->first.compare(0, prefix.length(), prefix);
+             ++it) {
+            sections.push_back(it->first);
+        }
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_ALLOCATION_FAILED;
+    }
+}
+
+E_Result LogConfig::GetSectionValue(const std::string& section,
+                                    const std::string& key,
+                                    std::string& value) {
+    /* Thread synchronization for data access */
+    std::lock_guard<std::mutex> lock(g_configMutex);
+
+    auto sectionIt = m_configData.find(section);
+    if (sectionIt == m_configData.end()) {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    auto keyIt = sectionIt->second.find(key);
+    if (keyIt == sectionIt->second.end()) {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    try {
+        value = keyIt->second;
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_ALLOCATION_FAILED;
+    }
+}
+
 } /* namespace logger */
-} /* namespace vsn */
\ No newline at end of file
+} /* namespace vsn */
@@ -0,0 +1,314 @@
+/**
+ * @file crash.cpp
+ * @brief Implementation of the crash-surviving log ring for VSNLogger
+ *
+ * @details
+ * The crash handler finds open rings through a fixed table of atomic
+ * pointers and touches nothing else, so it is async-signal-safe even when
+ * the fault hit inside a sink holding its lock. Ring data may end with a
+ * record that was being copied when the process died; it lies past the
+ * published head and is not decoded.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include "vsnlogger/crash.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <mutex>
+#include <new>
+
+namespace vsn {
+namespace logger {
+namespace crash {
+
+/* Fatal signals marked in the rings */
+static const int k_crashSignals[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL,
+                                     SIGABRT};
+
+static constexpr std::size_t k_crashSignalCount =
+    sizeof(k_crashSignals) / sizeof(k_crashSignals[0]);
+
+/* Open rings, read by the crash handler */
+static std::atomic<CrashRingHeader_t*> g_rings[k_maxCrashRings];
+
+/* Actions replaced by the crash handler, restored before re-raising */
+static struct sigaction g_previousActions[k_crashSignalCount];
+
+/* Serializes handler installation */
+static std::mutex g_crashMutex;
+
+/* Set once the handler is installed */
+static bool g_handlerInstalled = false;
+
+/* Record the fatal signal in every open ring and pass the signal on */
+static void CrashHandler(int signal) {
+    for (std::uint32_t i = 0U; i < k_maxCrashRings; ++i) {
+        CrashRingHeader_t* const header =
+            g_rings[i].load(std::memory_order_acquire);
+        if (nullptr != header) {
+            header->m_crashHead.store(
+                header->m_head.load(std::memory_order_acquire),
+                std::memory_order_relaxed);
+            header->m_signal.store(signal, std::memory_order_relaxed);
+            header->m_state.store(
+                static_cast<std::uint32_t>(E_CrashRingState::E_CRASHED),
+                std::memory_order_release);
+        }
+    }
+
+    for (std::size_t i = 0U; i < k_crashSignalCount; ++i) {
+        if (k_crashSignals[i] == signal) {
+            static_cast<void>(
+                sigaction(signal, &g_previousActions[i], nullptr));
+        }
+    }
+    static_cast<void>(raise(signal));
+}
+
+CrashRing::CrashRing(void)
+    : m_header(nullptr),
+      m_data(nullptr),
+      m_mappedSize(0U),
+      m_slot(k_maxCrashRings) {}
+
+CrashRing::~CrashRing(void) { Close(); }
+
+E_Result CrashRing::Open(const std::string& path, std::uint64_t capacity) {
+    if (path.empty() || (capacity < k_minCrashRingSize) ||
+        (capacity > k_maxCrashRingSize)) {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    if (nullptr != m_header) {
+        return E_Result::E_INVALID_STATE;
+    }
+
+    try {
+        const std::filesystem::path filePath(path);
+        const std::filesystem::path dirPath = filePath.parent_path();
+        if (!dirPath.empty() && !std::filesystem::exists(dirPath)) {
+            std::filesystem::create_directories(dirPath);
+        }
+
+        /* Keep the previous run for recovery */
+        std::error_code error;
+        if (std::filesystem::exists(filePath, error)) {
+            std::filesystem::rename(filePath, path + ".prev", error);
+        }
+
+        const int fd =
+            open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return E_Result::E_FILE_ERROR;
+        }
+
+        /* Allocate the blocks now so a full disk cannot fault a write */
+        const std::size_t size =
+            static_cast<std::size_t>(k_crashRingHeaderSize + capacity);
+        void* base = MAP_FAILED;
+        if (0 == posix_fallocate(fd, 0, static_cast<off_t>(size))) {
+            base = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, 0);
+        }
+        static_cast<void>(close(fd));
+        if (MAP_FAILED == base) {
+            return E_Result::E_FILE_ERROR;
+        }
+
+        CrashRingHeader_t* const header = new (base) CrashRingHeader_t;
+        std::memcpy(header->m_magic, k_crashRingMagic,
+                    sizeof(header->m_magic));
+        header->m_version = k_crashRingVersion;
+        header->m_headerSize = k_crashRingHeaderSize;
+        header->m_capacity = capacity;
+        header->m_pid = static_cast<std::int64_t>(getpid());
+        header->m_startTime = static_cast<std::int64_t>(std::time(nullptr));
+        header->m_head.store(0U, std::memory_order_relaxed);
+        header->m_signal.store(0, std::memory_order_relaxed);
+        header->m_crashHead.store(0U, std::memory_order_relaxed);
+        header->m_state.store(
+            static_cast<std::uint32_t>(E_CrashRingState::E_ACTIVE),
+            std::memory_order_release);
+
+        m_header = header;
+        m_data = static_cast<char*>(base) + k_crashRingHeaderSize;
+        m_mappedSize = size;
+
+        /* A ring missing from a full table still records, unmarked */
+        for (std::uint32_t i = 0U; i < k_maxCrashRings; ++i) {
+            CrashRingHeader_t* expected = nullptr;
+            if (g_rings[i].compare_exchange_strong(
+                    expected, header, std::memory_order_release)) {
+                m_slot = i;
+                break;
+            }
+        }
+
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_FILE_ERROR;
+    }
+}
+
+void CrashRing::Write(const char* data, std::size_t size) {
+    if ((nullptr == m_header) || (0U == size)) {
+        return;
+    }
+
+    const std::uint64_t capacity = m_header->m_capacity;
+    const std::uint64_t head = m_header->m_head.load(std::memory_order_relaxed);
+    const std::uint64_t end = head + size;
+
+    /* Only the last capacity bytes of an oversized write survive */
+    if (size > capacity) {
+        data += size - capacity;
+        size = static_cast<std::size_t>(capacity);
+    }
+
+    const std::size_t offset =
+        static_cast<std::size_t>((end - size) % capacity);
+    const std::size_t first =
+        std::min(size, static_cast<std::size_t>(capacity) - offset);
+    std::memcpy(m_data + offset, data, first);
+    if (size > first) {
+        std::memcpy(m_data, data + first, size - first);
+    }
+
+    m_header->m_head.store(end, std::memory_order_release);
+}
+
+void CrashRing::Close(void) {
+    if (nullptr == m_header) {
+        return;
+    }
+
+    if (m_slot < k_maxCrashRings) {
+        g_rings[m_slot].store(nullptr, std::memory_order_release);
+        m_slot = k_maxCrashRings;
+    }
+
+    m_header->m_state.store(
+        static_cast<std::uint32_t>(E_CrashRingState::E_CLOSED),
+        std::memory_order_release);
+    static_cast<void>(munmap(m_header, m_mappedSize));
+
+    m_header = nullptr;
+    m_data = nullptr;
+    m_mappedSize = 0U;
+}
+
+E_Result InstallCrashHandler(void) {
+    try {
+        std::lock_guard<std::mutex> lock(g_crashMutex);
+
+        if (g_handlerInstalled) {
+            return E_Result::E_SUCCESS;
+        }
+
+        struct sigaction action;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_handler = &CrashHandler;
+        static_cast<void>(sigemptyset(&action.sa_mask));
+
+        for (std::size_t i = 0U; i < k_crashSignalCount; ++i) {
+            if (0 != sigaction(k_crashSignals[i], &action,
+                               &g_previousActions[i])) {
+                return E_Result::E_RESOURCE_UNAVAILABLE;
+            }
+        }
+
+        g_handlerInstalled = true;
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_Result RecoverCrashRing(const std::string& path, std::string& text,
+                          CrashRingInfo_t& info) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return E_Result::E_FILE_ERROR;
+    }
+
+    struct stat status;
+    if (0 != fstat(fd, &status)) {
+        static_cast<void>(close(fd));
+        return E_Result::E_FILE_ERROR;
+    }
+    if (status.st_size < static_cast<off_t>(k_crashRingHeaderSize)) {
+        static_cast<void>(close(fd));
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    const std::size_t size = static_cast<std::size_t>(status.st_size);
+    void* const base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    static_cast<void>(close(fd));
+    if (MAP_FAILED == base) {
+        return E_Result::E_FILE_ERROR;
+    }
+
+    E_Result result = E_Result::E_SUCCESS;
+    try {
+        const CrashRingHeader_t* const header =
+            static_cast<const CrashRingHeader_t*>(base);
+        const std::uint64_t capacity = header->m_capacity;
+
+        if ((0 != std::memcmp(header->m_magic, k_crashRingMagic,
+                              sizeof(k_crashRingMagic))) ||
+            (k_crashRingVersion != header->m_version) ||
+            (k_crashRingHeaderSize != header->m_headerSize) ||
+            (0U == capacity) || (capacity > size - k_crashRingHeaderSize)) {
+            result = E_Result::E_INVALID_PARAMETER;
+        } else {
+            const char* const data =
+                static_cast<const char*>(base) + k_crashRingHeaderSize;
+            const std::uint64_t head =
+                header->m_head.load(std::memory_order_acquire);
+
+            info.m_state =
+                static_cast<E_CrashRingState>(header->m_state.load());
+            info.m_signal = header->m_signal.load();
+            info.m_pid = header->m_pid;
+            info.m_startTime = header->m_startTime;
+            info.m_written = head;
+            info.m_wrapped = (head > capacity);
+
+            if (!info.m_wrapped) {
+                text.assign(data, static_cast<std::size_t>(head));
+            } else {
+                /* Oldest byte sits at the write position */
+                const std::size_t start =
+                    static_cast<std::size_t>(head % capacity);
+                text.assign(data + start,
+                            static_cast<std::size_t>(capacity) - start);
+                text.append(data, start);
+
+                const std::size_t newline = text.find('\n');
+                text.erase(0U, (std::string::npos == newline)
+                                   ? text.size()
+                                   : newline + 1U);
+            }
+        }
+    } catch (...) {
+        result = E_Result::E_UNKNOWN_ERROR;
+    }
+
+    static_cast<void>(munmap(base, size));
+    return result;
+}
+
+} /* namespace crash */
+} /* namespace logger */
+} /* namespace vsn */
@@ -13,86 +13,249 @@
 
 #include "vsnlogger/formatters.h"
 
-#include <chrono>
+#include <spdlog/details/log_msg.h>
+#include <spdlog/details/os.h>
+#include <spdlog/pattern_formatter.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
 #include <ctime>
-#include <iomanip>
 #include <sstream>
+#include <utility>
+
+#include "vsnlogger/clock.h"
+#include "vsnlogger/kv.h"
 
 namespace vsn {
 namespace logger {
 namespace formatters {
 
-/* Helper function to get current timestamp with bounds checking */
-static E_Result GetCurrentTimestamp(std::string& result) {
-    try {
-        auto now = std::chrono::system_clock::now();
-        auto timeT = std::chrono::system_clock::to_time_t(now);
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                      now.time_since_epoch()) %
-                  1000;
+/* Length of the cached "YYYY-MM-DDTHH:MM:SS" prefix */
+static constexpr std::size_t k_timestampPrefixLength = 19U;
 
-        std::tm timeInfo;
+/* Two ASCII digits for every value below 100 */
+static constexpr char k_digitPairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233"
+    "34353637383940414243444546474849505152535455565758596061626364656667"
+    "6869707172737475767778798081828384858687888990919293949596979899";
+
+/**
+ * @brief Timestamp prefix of the last second rendered by a thread
+ */
+struct TimestampCache_t {
+    std::int64_t m_second;                   /**< Seconds since the epoch */
+    char m_prefix[k_timestampPrefixLength];  /**< Rendered date and time */
+};
+
+/* Last second rendered by the calling thread, -1 before the first */
+static thread_local TimestampCache_t t_timestampCache = {-1, {}};
+
+/* Write a value below 100 as two digits */
+static inline void WriteDigitPair(char* out, std::uint32_t value) {
+    out[0] = k_digitPairs[value * 2U];
+    out[1] = k_digitPairs[(value * 2U) + 1U];
+}
+
+/* Render the date and time of a second into the cache */
+static E_Result RenderTimestampPrefix(std::int64_t second,
+                                      TimestampCache_t& cache) {
+    const std::time_t timeT = static_cast<std::time_t>(second);
+    std::tm timeInfo;
 
 #ifdef _WIN32
-        /* Windows-specific thread-safe version */
-        if (0 != gmtime_s(&timeInfo, &timeT)) {
-            return E_Result::E_UNKNOWN_ERROR;
-        }
+    /* Windows-specific thread-safe version */
+    if (0 != gmtime_s(&timeInfo, &timeT)) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
 #else
-        /* POSIX thread-safe version */
-        if (nullptr == gmtime_r(&timeT, &timeInfo)) {
-            return E_Result::E_UNKNOWN_ERROR;
-        }
+    /* POSIX thread-safe version */
+    if (nullptr == gmtime_r(&timeT, &timeInfo)) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
 #endif
 
-        /* Format timestamp with stringstream for bounds safety */
-        std::stringstream ss;
-        ss << std::put_time(&timeInfo, "%Y-%m-%dT%H:%M:%S");
-        ss << '.' << std::setfill('0') << std::setw(3) << ms.count() << 'Z';
+    const std::uint32_t year = static_cast<std::uint32_t>(timeInfo.tm_year) +
+                               1900U;
+    if (year > 9999U) {
+        return E_Result::E_INVALID_PARAMETER;
+    }
 
-        result = ss.str();
-        return E_Result::E_SUCCESS;
-    } catch (...) {
-        return E_Result::E_UNKNOWN_ERROR;
+    char* const out = cache.m_prefix;
+    WriteDigitPair(out, year / 100U);
+    WriteDigitPair(out + 2, year % 100U);
+    out[4] = '-';
+    WriteDigitPair(out + 5, static_cast<std::uint32_t>(timeInfo.tm_mon) + 1U);
+    out[7] = '-';
+    WriteDigitPair(out + 8, static_cast<std::uint32_t>(timeInfo.tm_mday));
+    out[10] = 'T';
+    WriteDigitPair(out + 11, static_cast<std::uint32_t>(timeInfo.tm_hour));
+    out[13] = ':';
+    WriteDigitPair(out + 14, static_cast<std::uint32_t>(timeInfo.tm_min));
+    out[16] = ':';
+    WriteDigitPair(out + 17, static_cast<std::uint32_t>(timeInfo.tm_sec));
+
+    cache.m_second = second;
+    return E_Result::E_SUCCESS;
+}
+
+E_Result FormatTimestamp(std::uint64_t nanos, E_TimestampPrecision precision,
+                         char* buffer, std::size_t size, std::size_t& length) {
+    const bool micros = (E_TimestampPrecision::E_MICROSECONDS == precision);
+    const std::size_t required =
+        k_timestampPrefixLength + (micros ? 8U : 5U);
+    if ((nullptr == buffer) || (size < required)) {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    const std::int64_t second = static_cast<std::int64_t>(nanos / 1000000000U);
+    const std::uint32_t fraction =
+        static_cast<std::uint32_t>(nanos % 1000000000U);
+
+    TimestampCache_t& cache = t_timestampCache;
+    if (cache.m_second != second) {
+        const E_Result result = RenderTimestampPrefix(second, cache);
+        if (E_Result::E_SUCCESS != result) {
+            return result;
+        }
+    }
+    std::memcpy(buffer, cache.m_prefix, k_timestampPrefixLength);
+
+    char* out = buffer + k_timestampPrefixLength;
+    *out++ = '.';
+    if (micros) {
+        const std::uint32_t us = fraction / 1000U;
+        WriteDigitPair(out, us / 10000U);
+        WriteDigitPair(out + 2, (us / 100U) % 100U);
+        WriteDigitPair(out + 4, us % 100U);
+        out += 6;
+    } else {
+        const std::uint32_t ms = fraction / 1000000U;
+        *out = static_cast<char>('0' + (ms / 100U));
+        WriteDigitPair(out + 1, ms % 100U);
+        out += 3;
     }
+    *out = 'Z';
+
+    length = required;
+    return E_Result::E_SUCCESS;
+}
+
+/* Render the current time of the selected clock source */
+static E_Result GetCurrentTimestamp(char (&timestamp)[k_maxTimestampLength],
+                                    std::size_t& length) {
+    return FormatTimestamp(
+        logger::detail::ClockTicksToNanos(logger::detail::ClockTicks()),
+        E_TimestampPrecision::E_MILLISECONDS, timestamp, sizeof(timestamp),
+        length);
+}
+
+/* Copy a string literal without its terminator to raw storage */
+template <std::size_t N>
+static inline char* CopyLiteral(char* out, const char (&text)[N]) {
+    std::memcpy(out, text, N - 1U);
+    return out + (N - 1U);
 }
 
-/* Helper function to JSON escape a string with bounds checking */
-static E_Result JsonEscapeString(const std::string& input,
-                                 std::string& output) {
+/* Key and value of an additional field, from either field container */
+static inline std::string_view FieldKey(const JsonField_t& field) {
+    return field.m_key;
+}
+static inline std::string_view FieldValue(const JsonField_t& field) {
+    return field.m_value;
+}
+static inline std::string_view FieldKey(
+    const std::pair<const std::string, std::string>& field) {
+    return field.first;
+}
+static inline std::string_view FieldValue(
+    const std::pair<const std::string, std::string>& field) {
+    return field.second;
+}
+
+/* Fixed keys and punctuation of a record and of one additional field */
+static constexpr std::size_t k_jsonRecordLength =
+    sizeof("{\"timestamp\":\"\",\"level\":\"\",\"component\":\"\","
+           "\"message\":\"\"}");
+static constexpr std::size_t k_jsonFieldLength = sizeof(",\"\":\"\"");
+
+/**
+ * @brief Write one JSON record with the additional fields [first, last)
+ *
+ * @details
+ * The destination grows once, to the worst case of every byte escaped,
+ * and is trimmed to what was written; the fields are read in place and
+ * escaped straight into it. On failure the destination is left unchanged.
+ *
+ * @param[in] replace Overwrite the destination instead of appending
+ */
+template <typename Buffer, typename FieldIt>
+static E_Result WriteJsonRecord(std::string_view message,
+                                std::string_view level,
+                                std::string_view component, FieldIt first,
+                                FieldIt last, bool replace, Buffer& out) {
+    /* Parameter validation */
+    if (message.empty() || level.empty()) {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    /* Get timestamp */
+    char timestamp[k_maxTimestampLength];
+    std::size_t timestampLength = 0U;
+    E_Result timestampResult = GetCurrentTimestamp(timestamp, timestampLength);
+    if (E_Result::E_SUCCESS != timestampResult) {
+        return timestampResult;
+    }
+
+    /* Additional fields are bounded to prevent resource exhaustion */
+    std::size_t fieldCount = 0U;
+    std::size_t textLength = level.size() + component.size() + message.size();
+    for (FieldIt field = first;
+         (field != last) && (fieldCount < k_maxJsonFields);
+         ++field, ++fieldCount) {
+        textLength += FieldKey(*field).size() + FieldValue(*field).size();
+    }
+
+    const std::size_t start = replace ? 0U : out.size();
+    out.resize(start + k_jsonRecordLength + timestampLength +
+               (fieldCount * k_jsonFieldLength) +
+               (textLength * JsonWriter::k_maxEscapedBytes));
+    char* const begin = &out[0] + start;
+
+    char* p = CopyLiteral(begin, "{\"timestamp\":\"");
+    std::memcpy(p, timestamp, timestampLength);
+    p = CopyLiteral(p + timestampLength, "\",\"level\":\"");
+    p = JsonWriter::Escape(level, p);
+    if (!component.empty()) {
+        p = CopyLiteral(p, "\",\"component\":\"");
+        p = JsonWriter::Escape(component, p);
+    }
+    p = CopyLiteral(p, "\",\"message\":\"");
+    p = JsonWriter::Escape(message, p);
+    *p++ = '"';
+
+    for (std::size_t count = 0U; count < fieldCount; ++first, ++count) {
+        p = CopyLiteral(p, ",\"");
+        p = JsonWriter::Escape(FieldKey(*first), p);
+        p = CopyLiteral(p, "\":\"");
+        p = JsonWriter::Escape(FieldValue(*first), p);
+        *p++ = '"';
+    }
+    *p++ = '}';
+
+    out.resize(start + static_cast<std::size_t>(p - begin));
+    return E_Result::E_SUCCESS;
+}
+
+E_Result ToJson(std::string_view message, std::string_view level,
+                std::string_view component, const JsonField_t* fields,
+                std::size_t fieldCount, spdlog::memory_buf_t& out) {
     try {
-        /* Reserve space to reduce allocations */
-        output.clear();
-        output.reserve(input.length() + 16U); /* Allow for some escaping */
-
-        for (std::size_t i = 0U; i < input.length(); ++i) {
-            const char c = input[i];
-            if (c == '\"') {
-                output += "\\\"";
-            } else if (c == '\\') {
-                output += "\\\\";
-            } else if (c == '\n') {
-                output += "\\n";
-            } else if (c == '\r') {
-                output += "\\r";
-            } else if (c == '\t') {
-                output += "\\t";
-            } else if (c == '\b') {
-                output += "\\b";
-            } else if (c == '\f') {
-                output += "\\f";
-            } else if (static_cast<unsigned char>(c) < 32U) {
-                /* Control characters as Unicode escapes */
-                char hexBuf[8];
-                std::snprintf(hexBuf, sizeof(hexBuf), "\\u%04x",
-                              static_cast<unsigned int>(c));
-                output += hexBuf;
-            } else {
-                output += c;
-            }
+        if ((nullptr == fields) && (0U != fieldCount)) {
+            return E_Result::E_INVALID_PARAMETER;
         }
-
-        return E_Result::E_SUCCESS;
+        return WriteJsonRecord(message, level, component, fields,
+                               fields + fieldCount, false, out);
     } catch (...) {
         return E_Result::E_UNKNOWN_ERROR;
     }
@@ -100,114 +263,168 @@ static E_Result JsonEscapeString(const std::string& input,
 
 E_Result ToJson(const std::string& message, const std::string& level,
                 const std::string& component, std::string& result) {
-    std::map<std::string, std::string> empty;
-    return ToJson(message, level, component, empty, result);
+    return ToJson(message, level, component, nullptr, 0U, result);
 }
 
 E_Result ToJson(const std::string& message, const std::string& level,
-                const std::string& component,
-                const std::map<std::string, std::string>& additionalFields,
-                std::string& result) {
+                const std::string& component, const JsonField_t* fields,
+                std::size_t fieldCount, std::string& result) {
     try {
-        /* Parameter validation */
-        if (message.empty() || level.empty()) {
+        if ((nullptr == fields) && (0U != fieldCount)) {
             return E_Result::E_INVALID_PARAMETER;
         }
 
-        /* Get timestamp */
-        std::string timestamp;
-        E_Result timestampResult = GetCurrentTimestamp(timestamp);
-        if (E_Result::E_SUCCESS != timestampResult) {
-            return timestampResult;
-        }
+        /* Written in place, the string's capacity is reused */
+        return WriteJsonRecord(message, level, component, fields,
+                               fields + fieldCount, true, result);
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
 
-        /* Prepare JSON output with stringstream for bounds safety */
-        std::stringstream json;
+E_Result ToJson(const std::string& message, const std::string& level,
+                const std::string& component,
+                const std::map<std::string, std::string>& additionalFields,
+                std::string& result) {
+    try {
+        /* Written in place, the string's capacity is reused */
+        return WriteJsonRecord(message, level, component,
+                               additionalFields.begin(),
+                               additionalFields.end(), true, result);
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
 
-        /* Start JSON object */
-        json << "{";
+void JsonFormatter::AddStaticField(std::string_view key,
+                                   std::string_view value) {
+    JsonWriter writer(m_staticFields);
+    if (0U != m_staticFieldCount) {
+        m_staticFields.push_back(',');
+    }
+    writer.AddString(key, value);
+    ++m_staticFieldCount;
+}
 
-        /* Add standard fields */
-        json << "\"timestamp\":\"" << timestamp << "\",";
-        json << "\"level\":\"";
+void JsonFormatter::AddStaticField(std::string_view key, std::int64_t value) {
+    JsonWriter writer(m_staticFields);
+    if (0U != m_staticFieldCount) {
+        m_staticFields.push_back(',');
+    }
+    const fmt::format_int digits(value);
+    writer.AddRaw(key, std::string_view(digits.data(), digits.size()));
+    ++m_staticFieldCount;
+}
 
-        /* Escape level string */
-        std::string escapedLevel;
-        E_Result levelResult = JsonEscapeString(level, escapedLevel);
-        if (E_Result::E_SUCCESS != levelResult) {
-            return levelResult;
-        }
-        json << escapedLevel << "\",";
+/* Append a string literal without its terminator */
+template <std::size_t N>
+static inline void AppendLiteral(spdlog::memory_buf_t& out,
+                                 const char (&text)[N]) {
+    out.append(text, text + (N - 1U));
+}
 
-        /* Add component if provided */
-        if (!component.empty()) {
-            json << "\"component\":\"";
-
-            /* Escape component string */
-            std::string escapedComponent;
-            E_Result componentResult =
-                JsonEscapeString(component, escapedComponent);
-            if (E_Result::E_SUCCESS != componentResult) {
-                return componentResult;
-            }
-            json << escapedComponent << "\",";
+/* Write the typed fields of a structured record */
+static void AddKvFields(const unsigned char* fields, JsonWriter& writer) {
+    logger::detail::KvReader_t reader(fields);
+    KvField_t field;
+    while (reader.Next(field)) {
+        switch (field.m_type) {
+            case E_KvType::E_INT:
+                writer.AddInteger(field.m_key, field.m_int);
+                break;
+            case E_KvType::E_UINT:
+                writer.AddUnsigned(field.m_key, field.m_uint);
+                break;
+            case E_KvType::E_DOUBLE:
+                writer.AddDouble(field.m_key, field.m_double);
+                break;
+            case E_KvType::E_BOOL:
+                writer.AddBool(field.m_key, field.m_bool);
+                break;
+            case E_KvType::E_STRING:
+            default:
+                writer.AddString(field.m_key, field.m_string);
+                break;
         }
+    }
+}
 
-        /* Add message */
-        json << "\"message\":\"";
+void JsonFormatter::format(const spdlog::details::log_msg& msg,
+                           spdlog::memory_buf_t& dest) {
+    char timestamp[k_maxTimestampLength];
+    std::size_t timestampLength = 0U;
+    if (E_Result::E_SUCCESS !=
+        FormatTimestamp(logger::detail::TimeToClockTicks(msg.time),
+                        E_TimestampPrecision::E_MICROSECONDS, timestamp,
+                        sizeof(timestamp), timestampLength)) {
+        timestampLength = 0U;
+    }
 
-        /* Escape message string */
-        std::string escapedMessage;
-        E_Result messageResult = JsonEscapeString(message, escapedMessage);
-        if (E_Result::E_SUCCESS != messageResult) {
-            return messageResult;
-        }
-        json << escapedMessage << "\"";
-
-        /* Add additional fields with strict bounds checking */
-        if (!additionalFields.empty()) {
-            const std::size_t k_maxFields = 32U;
-            const std::size_t fieldCount =
-                (additionalFields.size() <= k_maxFields)
-                    ? additionalFields.size()
-                    : k_maxFields;
-
-            std::size_t processedFields = 0U;
-
-            for (const auto& field : additionalFields) {
-                if (processedFields >= fieldCount) {
-                    break;
-                }
-
-                json << ",\"";
-
-                /* Escape key string */
-                std::string escapedKey;
-                E_Result keyResult = JsonEscapeString(field.first, escapedKey);
-                if (E_Result::E_SUCCESS != keyResult) {
-                    continue;
-                }
-                json << escapedKey << "\":\"";
-
-                /* Escape value string */
-                std::string escapedValue;
-                E_Result valueResult =
-                    JsonEscapeString(field.second, escapedValue);
-                if (E_Result::E_SUCCESS != valueResult) {
-                    continue;
-                }
-                json << escapedValue << "\"";
-
-                ++processedFields;
-            }
-        }
+    const spdlog::string_view_t level =
+        spdlog::level::to_string_view(msg.level);
+    const fmt::format_int thread(msg.thread_id);
+
+    /* Keys, timestamp and level names never need escaping, so the fixed
+     * fields are appended as they are; only the text is escaped */
+    AppendLiteral(dest, "{\"timestamp\":\"");
+    dest.append(timestamp, timestamp + timestampLength);
+    AppendLiteral(dest, "\",\"level\":\"");
+    dest.append(level.data(), level.data() + level.size());
+    AppendLiteral(dest, "\",\"logger\":\"");
+    JsonWriter::AppendEscaped(
+        std::string_view(msg.logger_name.data(), msg.logger_name.size()),
+        dest);
+    AppendLiteral(dest, "\",\"thread\":");
+    dest.append(thread.data(), thread.data() + thread.size());
+
+    /* Structured records: the fields follow the message, keeping types */
+    std::string_view message(msg.payload.data(), msg.payload.size());
+    const logger::detail::KvContext_t* const kv =
+        logger::detail::CurrentKvContext(msg.payload.data());
+    if (nullptr != kv) {
+        message = message.substr(0U, kv->m_messageLength);
+    }
+    AppendLiteral(dest, ",\"message\":\"");
+    JsonWriter::AppendEscaped(message, dest);
+    dest.push_back('"');
+    if (nullptr != kv) {
+        JsonWriter writer(dest);
+        writer.ContinueObject();
+        AddKvFields(kv->m_fields, writer);
+    }
+    if (0U != m_staticFieldCount) {
+        dest.push_back(',');
+        dest.append(m_staticFields.data(),
+                    m_staticFields.data() + m_staticFields.size());
+    }
+    dest.push_back('}');
 
-        /* Close JSON object */
-        json << "}";
+    const char* const eol = spdlog::details::os::default_eol;
+    dest.append(eol, eol + std::strlen(eol));
+}
 
-        /* Set result */
-        result = json.str();
+std::unique_ptr<spdlog::formatter> JsonFormatter::clone(void) const {
+    std::unique_ptr<JsonFormatter> copy(new JsonFormatter());
+    copy->m_staticFields.append(m_staticFields.data(),
+                                m_staticFields.data() + m_staticFields.size());
+    copy->m_staticFieldCount = m_staticFieldCount;
+    return copy;
+}
 
+E_Result CreateJsonFormatter(const std::string& appName,
+                             std::unique_ptr<spdlog::formatter>& formatter) {
+    try {
+        std::unique_ptr<JsonFormatter> json(new JsonFormatter());
+        json->AddStaticField("app", appName);
+        json->AddStaticField(
+            "pid", static_cast<std::int64_t>(spdlog::details::os::pid()));
+
+        char host[256] = "";
+        if (0 == gethostname(host, sizeof(host) - 1U)) {
+            json->AddStaticField("host", host);
+        }
+
+        formatter = std::move(json);
         return E_Result::E_SUCCESS;
     } catch (...) {
         return E_Result::E_UNKNOWN_ERROR;
@@ -223,8 +440,10 @@ E_Result ToSyslog(const std::string& message, const std::string& level,
         }
 
         /* Get timestamp */
-        std::string timestamp;
-        E_Result timestampResult = GetCurrentTimestamp(timestamp);
+        char timestamp[k_maxTimestampLength];
+        std::size_t timestampLength = 0U;
+        E_Result timestampResult =
+            GetCurrentTimestamp(timestamp, timestampLength);
         if (E_Result::E_SUCCESS != timestampResult) {
             return timestampResult;
         }
@@ -248,7 +467,9 @@ E_Result ToSyslog(const std::string& message, const std::string& level,
         }
 
         /* Format: <priority>timestamp component: message */
-        ss << "<" << priority << ">" << timestamp << " ";
+        ss << "<" << priority << ">";
+        ss.write(timestamp, static_cast<std::streamsize>(timestampLength));
+        ss << " ";
 
         /* Add component if provided */
         if (!component.empty()) {
@@ -283,8 +504,10 @@ E_Result ToConsole(const std::string& message, const std::string& level,
         }
 
         /* Get timestamp */
-        std::string timestamp;
-        E_Result timestampResult = GetCurrentTimestamp(timestamp);
+        char timestamp[k_maxTimestampLength];
+        std::size_t timestampLength = 0U;
+        E_Result timestampResult =
+            GetCurrentTimestamp(timestamp, timestampLength);
         if (E_Result::E_SUCCESS != timestampResult) {
             return timestampResult;
         }
@@ -293,7 +516,9 @@ E_Result ToConsole(const std::string& message, const std::string& level,
         std::stringstream ss;
 
         /* Format: [timestamp] [level] [component] message */
-        ss << "[" << timestamp << "] ";
+        ss << "[";
+        ss.write(timestamp, static_cast<std::streamsize>(timestampLength));
+        ss << "] ";
         ss << "[" << level << "] ";
 
         /* Add component if provided */
@@ -312,16 +537,32 @@ E_Result ToConsole(const std::string& message, const std::string& level,
     }
 }
 
+/* Map a format name to its type, unknown names to E_DEFAULT */
+static E_FormatType ParseFormatType(const std::string& formatName) {
+    if (formatName == "json") {
+        return E_FormatType::E_JSON;
+    } else if (formatName == "console") {
+        return E_FormatType::E_CONSOLE;
+    } else if (formatName == "simple") {
+        return E_FormatType::E_SIMPLE;
+    } else if (formatName == "minimal") {
+        return E_FormatType::E_MINIMAL;
+    } else if (formatName == "colored") {
+        return E_FormatType::E_COLORED;
+    } else if (formatName == "detailed") {
+        return E_FormatType::E_DETAILED;
+    }
+    return E_FormatType::E_DEFAULT;
+}
+
 E_Result GetPattern(E_FormatType formatType, std::string& pattern) {
     try {
         /* Convert enum to string pattern based on type */
         switch (formatType) {
             case E_FormatType::E_JSON:
-                pattern =
-                    "{\"timestamp\":\"%Y-%m-%dT%H:%M:%S.%fZ\",\"level\":\"%^%l%"
-                    "$\","
-                    "\"logger\":\"%n\",\"thread\":\"%t\",\"message\":\"%v\"}";
-                break;
+                /* No pattern escapes the message, JsonFormatter does */
+                pattern.clear();
+                return E_Result::E_INVALID_PARAMETER;
 
             case E_FormatType::E_CONSOLE:
                 pattern = "%Y-%m-%d %H:%M:%S.%f %z [%^%l%$] [%n] [%t] %v";
@@ -366,27 +607,43 @@ E_Result GetPattern(const std::string& formatName, std::string& pattern) {
             return E_Result::E_INVALID_PARAMETER;
         }
 
-        /* Convert string to enum */
-        E_FormatType formatType;
-
-        if (formatName == "json") {
-            formatType = E_FormatType::E_JSON;
-        } else if (formatName == "console") {
-            formatType = E_FormatType::E_CONSOLE;
-        } else if (formatName == "simple") {
-            formatType = E_FormatType::E_SIMPLE;
-        } else if (formatName == "minimal") {
-            formatType = E_FormatType::E_MINIMAL;
-        } else if (formatName == "colored") {
-            formatType = E_FormatType::E_COLORED;
-        } else if (formatName == "detailed") {
-            formatType = E_FormatType::E_DETAILED;
-        } else {
-            formatType = E_FormatType::E_DEFAULT;
+        return GetPattern(ParseFormatType(formatName), pattern);
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_Result CreateFormatter(E_FormatType formatType, const std::string& appName,
+                         std::unique_ptr<spdlog::formatter>& formatter) {
+    try {
+        if (E_FormatType::E_JSON == formatType) {
+            return CreateJsonFormatter(appName, formatter);
+        }
+
+        std::string pattern;
+        const E_Result result = GetPattern(formatType, pattern);
+        if (E_Result::E_SUCCESS != result) {
+            return result;
+        }
+
+        formatter.reset(new spdlog::pattern_formatter(pattern));
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_Result CreateFormatter(const std::string& formatName,
+                         const std::string& appName,
+                         std::unique_ptr<spdlog::formatter>& formatter) {
+    try {
+        /* Parameter validation */
+        if (formatName.empty()) {
+            return E_Result::E_INVALID_PARAMETER;
         }
 
-        /* Get pattern from enum */
-        return GetPattern(formatType, pattern);
+        return CreateFormatter(ParseFormatType(formatName), appName,
+                               formatter);
     } catch (...) {
         return E_Result::E_UNKNOWN_ERROR;
     }
@@ -0,0 +1,299 @@
+/**
+ * @file json.cpp
+ * @brief Implementation of the streaming JSON writer for VSNLogger
+ *
+ * @details
+ * Escaping copies runs of bytes that need no escape in one append, so
+ * clean text costs one copy. On x86 the runs are found 16 bytes at a time
+ * with SSE2, or 32 with AVX2 when the processor has it, comparing against
+ * the quote, the backslash and the control range at once; only the bytes
+ * that matched are looked up in the escape table. Elsewhere, and for the
+ * tail of the input, every byte is looked up.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include "vsnlogger/json.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <immintrin.h>
+#define VSN_HAS_SIMD_ESCAPE 1
+#else
+#define VSN_HAS_SIMD_ESCAPE 0
+#endif
+
+namespace vsn {
+namespace logger {
+
+/* Build the escape of every byte: 0 copies it, 'u' writes \u00XX, any
+ * other value c writes \c */
+static constexpr std::array<char, 256> BuildJsonEscapes(void) {
+    std::array<char, 256> escapes{};
+    for (std::size_t c = 0U; c < 0x20U; ++c) {
+        escapes[c] = 'u';
+    }
+    escapes[static_cast<std::size_t>('"')] = '"';
+    escapes[static_cast<std::size_t>('\\')] = '\\';
+    escapes[static_cast<std::size_t>('\n')] = 'n';
+    escapes[static_cast<std::size_t>('\r')] = 'r';
+    escapes[static_cast<std::size_t>('\t')] = 't';
+    escapes[static_cast<std::size_t>('\b')] = 'b';
+    escapes[static_cast<std::size_t>('\f')] = 'f';
+    return escapes;
+}
+
+static constexpr std::array<char, 256> k_jsonEscapes = BuildJsonEscapes();
+
+static constexpr char k_hexDigits[] = "0123456789abcdef";
+
+/* Longest escape sequence written for one byte */
+static constexpr std::size_t k_maxEscapeLength = JsonWriter::k_maxEscapedBytes;
+
+/* Bytes escaped per kernel call, a whole number of SIMD blocks */
+static constexpr std::size_t k_escapeChunkLength = 64U;
+
+/* Write the escape sequence of a byte marked in k_jsonEscapes */
+static inline char* WriteEscape(unsigned char c, char* out) {
+    const char escape = k_jsonEscapes[c];
+    out[0] = '\\';
+    if ('u' == escape) {
+        out[1] = 'u';
+        out[2] = '0';
+        out[3] = '0';
+        out[4] = k_hexDigits[c >> 4U];
+        out[5] = k_hexDigits[c & 0x0FU];
+        return out + 6;
+    }
+    out[1] = escape;
+    return out + 2;
+}
+
+/* Copy the pending run [run, to); runs are mostly short, those are moved
+ * inline with overlapping fixed-size copies instead of a memcpy() call */
+static inline char* CopyRun(const char* run, const char* to, char* out) {
+    const std::size_t size = static_cast<std::size_t>(to - run);
+    if (size > 16U) {
+        std::memcpy(out, run, size);
+    } else if (size >= 8U) {
+        std::memcpy(out, run, 8U);
+        std::memcpy(out + size - 8U, run + size - 8U, 8U);
+    } else if (size >= 4U) {
+        std::memcpy(out, run, 4U);
+        std::memcpy(out + size - 4U, run + size - 4U, 4U);
+    } else if (0U != size) {
+        out[0] = run[0];
+        out[size / 2U] = run[size / 2U];
+        out[size - 1U] = run[size - 1U];
+    }
+    return out + size;
+}
+
+/* Escape [p, end), bytes from run on are pending a copy */
+static char* EscapeScalar(const char* run, const char* p, const char* end,
+                          char* out) {
+    for (; p != end; ++p) {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        if (0 == k_jsonEscapes[c]) {
+            continue;
+        }
+        out = WriteEscape(c, CopyRun(run, p, out));
+        run = p + 1;
+    }
+    return CopyRun(run, end, out);
+}
+
+/* Escape the bytes of a block flagged in mask, advancing run and out */
+static inline char* EscapeBlock(const char*& run, const char* block,
+                                std::uint32_t mask, char* out) {
+    while (0U != mask) {
+        const char* const hit =
+            block + static_cast<std::uint32_t>(__builtin_ctz(mask));
+        out = WriteEscape(static_cast<unsigned char>(*hit),
+                          CopyRun(run, hit, out));
+        run = hit + 1;
+        mask &= mask - 1U;
+    }
+    return out;
+}
+
+/* Byte-at-a-time kernel, also the reference for the others */
+static char* EscapeBytes(const char* text, const char* end, char* out) {
+    return EscapeScalar(text, text, end, out);
+}
+
+#if VSN_HAS_SIMD_ESCAPE
+
+/* Flag the bytes of a 16-byte block that need an escape */
+static inline std::uint32_t EscapeMask(__m128i bytes) {
+    const __m128i control = _mm_set1_epi8(0x1F);
+    /* Unsigned byte <= 0x1F exactly when max(byte, 0x1F) == 0x1F */
+    const __m128i hits = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')),
+                     _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))),
+        _mm_cmpeq_epi8(_mm_max_epu8(bytes, control), control));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(hits));
+}
+
+/* Load the 0 < n < 16 bytes at p, zero above, without reading past them.
+ * Overlapping loads are merged in registers: storing the bytes to a stack
+ * block and loading it back stalls on store forwarding. */
+static inline __m128i LoadTail(const char* p, std::size_t n) {
+    std::uint64_t low = 0U;
+    std::uint64_t high = 0U;
+    if (n >= 8U) {
+        std::memcpy(&low, p, 8U);
+        if (n > 8U) {
+            std::memcpy(&high, p + n - 8U, 8U);
+            high >>= (16U - n) * 8U;
+        }
+    } else if (n >= 4U) {
+        std::uint32_t first = 0U;
+        std::uint32_t last = 0U;
+        std::memcpy(&first, p, 4U);
+        std::memcpy(&last, p + n - 4U, 4U);
+        low = first | ((static_cast<std::uint64_t>(last) >> ((8U - n) * 8U))
+                       << 32U);
+    } else {
+        low = static_cast<unsigned char>(p[0]) |
+              (static_cast<std::uint64_t>(static_cast<unsigned char>(
+                   p[n / 2U]))
+               << ((n / 2U) * 8U)) |
+              (static_cast<std::uint64_t>(static_cast<unsigned char>(
+                   p[n - 1U]))
+               << ((n - 1U) * 8U));
+    }
+    return _mm_set_epi64x(static_cast<long long>(high),
+                          static_cast<long long>(low));
+}
+
+/* Escape the last 0 <= n < 16 bytes, from p on */
+static inline char* EscapeTail(const char*& run, const char* p,
+                               std::size_t n, char* out) {
+    if (0U == n) {
+        return out;
+    }
+    /* Zero padding would read as control bytes, mask it off */
+    const std::uint32_t mask = EscapeMask(LoadTail(p, n)) & ((1U << n) - 1U);
+    return EscapeBlock(run, p, mask, out);
+}
+
+/* 16 bytes at a time, SSE2 is part of every x86-64 processor */
+static char* EscapeSse2(const char* text, const char* end, char* out) {
+    const char* run = text;
+    const char* p = text;
+    for (; (end - p) >= 16; p += 16) {
+        const std::uint32_t mask = EscapeMask(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+        if (0U != mask) {
+            out = EscapeBlock(run, p, mask, out);
+        }
+    }
+
+    out = EscapeTail(run, p, static_cast<std::size_t>(end - p), out);
+    return CopyRun(run, end, out);
+}
+
+/* 32 bytes at a time */
+__attribute__((target("avx2"))) static char* EscapeAvx2(const char* text,
+                                                        const char* end,
+                                                        char* out) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+
+    const char* run = text;
+    const char* p = text;
+    for (; (end - p) >= 32; p += 32) {
+        const __m256i bytes =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, quote),
+                            _mm256_cmpeq_epi8(bytes, backslash)),
+            _mm256_cmpeq_epi8(_mm256_max_epu8(bytes, control), control));
+        const std::uint32_t mask =
+            static_cast<std::uint32_t>(_mm256_movemask_epi8(hits));
+        if (0U != mask) {
+            out = EscapeBlock(run, p, mask, out);
+        }
+    }
+
+    /* Less than 32 bytes left, finish 16 at a time */
+    if ((end - p) >= 16) {
+        const std::uint32_t mask = EscapeMask(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+        if (0U != mask) {
+            out = EscapeBlock(run, p, mask, out);
+        }
+        p += 16;
+    }
+    out = EscapeTail(run, p, static_cast<std::size_t>(end - p), out);
+    return CopyRun(run, end, out);
+}
+
+/* Whether the processor runs the AVX2 kernel */
+static bool HasAvx2(void) {
+    __builtin_cpu_init();
+    return 0 != __builtin_cpu_supports("avx2");
+}
+
+/* Pick the widest kernel the processor runs */
+static detail::EscapeFn_t SelectEscapeKernel(void) {
+    return HasAvx2() ? &EscapeAvx2 : &EscapeSse2;
+}
+
+#else
+
+static detail::EscapeFn_t SelectEscapeKernel(void) { return &EscapeBytes; }
+
+#endif
+
+namespace detail {
+
+EscapeKernels_t GetEscapeKernels(void) {
+#if VSN_HAS_SIMD_ESCAPE
+    return EscapeKernels_t{&EscapeBytes, &EscapeSse2,
+                           HasAvx2() ? &EscapeAvx2 : nullptr};
+#else
+    return EscapeKernels_t{&EscapeBytes, nullptr, nullptr};
+#endif
+}
+
+} /* namespace detail */
+
+/* Kernel for this processor, chosen on first use */
+static detail::EscapeFn_t EscapeKernel(void) {
+    static const detail::EscapeFn_t kernel = SelectEscapeKernel();
+    return kernel;
+}
+
+char* JsonWriter::Escape(std::string_view text, char* out) {
+    return EscapeKernel()(text.data(), text.data() + text.size(), out);
+}
+
+void JsonWriter::AppendEscaped(std::string_view text,
+                               spdlog::memory_buf_t& out) {
+    const detail::EscapeFn_t kernel = EscapeKernel();
+
+    /* Room for the worst case of one chunk at a time, trimmed to what was
+     * written, so the buffer outgrows the text by at most one chunk */
+    const char* p = text.data();
+    const char* const end = p + text.size();
+    while (p != end) {
+        const std::size_t chunk = std::min(
+            static_cast<std::size_t>(end - p), k_escapeChunkLength);
+        const std::size_t start = out.size();
+        out.resize(start + (chunk * k_maxEscapeLength));
+        char* const dest = out.data() + start;
+        char* const written = kernel(p, p + chunk, dest);
+        out.resize(start + static_cast<std::size_t>(written - dest));
+        p += chunk;
+    }
+}
+
+} /* namespace logger */
+} /* namespace vsn */
@@ -0,0 +1,149 @@
+/**
+ * @file kv.cpp
+ * @brief Implementation of structured record fields for VSNLogger
+ *
+ * @details
+ * Text rendering follows logfmt: a string is written bare unless it is
+ * empty or holds a space, '=', a quote or a control byte, in which case it
+ * is quoted and escaped like a JSON string.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include "vsnlogger/kv.h"
+
+#include <spdlog/fmt/compile.h>
+
+#include <iterator>
+
+#include "vsnlogger/component.h"
+#include "vsnlogger/json.h"
+
+namespace vsn {
+namespace logger {
+namespace detail {
+
+thread_local const KvContext_t* t_kvContext = nullptr;
+
+bool KvReader_t::Next(KvField_t& field) {
+    if (0U == m_remaining) {
+        return false;
+    }
+    --m_remaining;
+
+    field.m_type = static_cast<E_KvType>(m_data[m_offset]);
+    const std::size_t keyLength = m_data[m_offset + 1U];
+    field.m_key = std::string_view(
+        reinterpret_cast<const char*>(m_data + m_offset + 2U), keyLength);
+    m_offset += 2U + keyLength;
+
+    const unsigned char* const value = m_data + m_offset;
+    switch (field.m_type) {
+        case E_KvType::E_INT:
+            std::memcpy(&field.m_int, value, sizeof(field.m_int));
+            m_offset += sizeof(field.m_int);
+            break;
+        case E_KvType::E_UINT:
+            std::memcpy(&field.m_uint, value, sizeof(field.m_uint));
+            m_offset += sizeof(field.m_uint);
+            break;
+        case E_KvType::E_DOUBLE:
+            std::memcpy(&field.m_double, value, sizeof(field.m_double));
+            m_offset += sizeof(field.m_double);
+            break;
+        case E_KvType::E_BOOL:
+            field.m_bool = (0U != *value);
+            m_offset += 1U;
+            break;
+        case E_KvType::E_STRING:
+        default: {
+            std::uint16_t length = 0U;
+            std::memcpy(&length, value, sizeof(length));
+            field.m_string = std::string_view(
+                reinterpret_cast<const char*>(value + sizeof(length)), length);
+            m_offset += sizeof(length) + length;
+            break;
+        }
+    }
+    return true;
+}
+
+/* True if a logfmt value must be quoted */
+static bool NeedsQuotes(std::string_view value) {
+    if (value.empty()) {
+        return true;
+    }
+    for (const char c : value) {
+        if ((' ' == c) || ('=' == c) || ('"' == c) ||
+            (static_cast<unsigned char>(c) < 0x20U)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DecodeKv(const char* message, const unsigned char* data,
+              spdlog::memory_buf_t& out) {
+    out.append(message, message + std::strlen(message));
+
+    KvReader_t reader(data);
+    KvField_t field;
+    while (reader.Next(field)) {
+        out.push_back(' ');
+        out.append(field.m_key.data(), field.m_key.data() + field.m_key.size());
+        out.push_back('=');
+
+        switch (field.m_type) {
+            case E_KvType::E_INT: {
+                const fmt::format_int digits(field.m_int);
+                out.append(digits.data(), digits.data() + digits.size());
+                break;
+            }
+            case E_KvType::E_UINT: {
+                const fmt::format_int digits(field.m_uint);
+                out.append(digits.data(), digits.data() + digits.size());
+                break;
+            }
+            case E_KvType::E_DOUBLE:
+                fmt::format_to(std::back_inserter(out), FMT_COMPILE("{}"),
+                               field.m_double);
+                break;
+            case E_KvType::E_BOOL: {
+                const std::string_view text(field.m_bool ? "true" : "false");
+                out.append(text.data(), text.data() + text.size());
+                break;
+            }
+            case E_KvType::E_STRING:
+            default:
+                if (NeedsQuotes(field.m_string)) {
+                    out.push_back('"');
+                    JsonWriter::AppendEscaped(field.m_string, out);
+                    out.push_back('"');
+                } else {
+                    out.append(field.m_string.data(),
+                               field.m_string.data() + field.m_string.size());
+                }
+                break;
+        }
+    }
+}
+
+const KvContext_t* BindKvContext(const async::AsyncRecord_t& record,
+                                 const char* text, KvContext_t& context) {
+    if (&DecodeKv != record.m_decode) {
+        return nullptr;
+    }
+
+    context.m_text = text;
+    context.m_messageLength =
+        std::strlen(record.m_format) +
+        ((nullptr != record.m_component) ? record.m_component->m_prefixLength
+                                         : 0U);
+    context.m_fields = record.m_payload;
+    return &context;
+}
+
+} /* namespace detail */
+} /* namespace logger */
+} /* namespace vsn */
@@ -5,6 +5,7 @@
 
 #include "vsnlogger/logger.h"
 
+#include <spdlog/pattern_formatter.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
@@ -14,9 +15,15 @@
 #include <iostream>
 #include <mutex>
 
+#include "vsnlogger/async.h"
+#include "vsnlogger/clock.h"
+#include "vsnlogger/component.h"
 #include "vsnlogger/config.h"
+#include "vsnlogger/crash.h"
 #include "vsnlogger/formatters.h"
+#include "vsnlogger/recorder.h"
 #include "vsnlogger/sinks.h"
+#include "vsnlogger/timer.h"
 
 namespace vsn {
 namespace logger {
@@ -24,11 +31,59 @@ namespace logger {
 /* Initialize static members */
 std::shared_ptr<Logger> Logger::ms_defaultInstance = nullptr;
 std::uint32_t Logger::ms_allocationCount = 0U;
+std::atomic<std::uint8_t> Logger::ms_levelFloor(0U);
 
-/* Thread synchronization for singleton access */
+/* Thread synchronization for singleton initialization and teardown */
 static std::mutex g_loggerMutex;
 
-Logger::Logger(const std::string& name) {
+/* Serializes flight recorder setup */
+static std::mutex g_recorderMutex;
+
+/* Text of structured records rendered on the calling thread */
+static thread_local spdlog::memory_buf_t t_kvScratch;
+
+/**
+ * @brief Outputs built by Initialize that [sink.<name>] sections configure
+ */
+struct ConfiguredOutputs_t {
+    std::shared_ptr<spdlog::sinks::sink> m_console; /**< Console, or null */
+    std::shared_ptr<spdlog::sinks::sink> m_file;    /**< Log file, or null */
+    std::shared_ptr<spdlog::sinks::sink> m_syslog;  /**< Syslog, or null */
+    std::shared_ptr<spdlog::sinks::sink> m_fanout;  /**< Fan-out, or null */
+};
+
+/* Outputs of the default instance, kept for SetPattern() */
+static ConfiguredOutputs_t g_outputs;
+
+/* Generation of the published default instance, bumped on every swap */
+static std::atomic<std::uint64_t> g_defaultGeneration(1U);
+
+/**
+ * @brief Per-thread cached pointer to the default logger handle
+ *
+ * @details
+ * Points at the published handle and is valid while the published
+ * generation equals m_generation. It owns nothing, so Shutdown() releases
+ * the instance, its sinks and files for every thread at once, and the
+ * cache needs no destructor at thread exit.
+ */
+struct DefaultLoggerCache_t {
+    std::uint64_t m_generation;
+    std::shared_ptr<Logger>* m_handle;
+};
+
+static thread_local DefaultLoggerCache_t t_defaultLoggerCache{0U, nullptr};
+
+/* Publish a new default instance to all threads (caller holds the mutex) */
+static void PublishDefaultInstance(void) {
+    g_defaultGeneration.fetch_add(1U, std::memory_order_release);
+}
+
+Logger::Logger(const std::string& name)
+    : m_deferredFormatting(false),
+      m_maxMessageLength(k_maxMessageLength),
+      m_recordLevel(k_recorderDisabled),
+      m_dumpLevel(k_recorderDisabled) {
     try {
         /* Check allocation limits */
         if (Logger::ms_allocationCount >= 32U) {
@@ -61,7 +116,11 @@ Logger::Logger(const std::string& name) {
     }
 }
 
-Logger::Logger(const std::string& name, const std::string& logFilePath) {
+Logger::Logger(const std::string& name, const std::string& logFilePath)
+    : m_deferredFormatting(false),
+      m_maxMessageLength(k_maxMessageLength),
+      m_recordLevel(k_recorderDisabled),
+      m_dumpLevel(k_recorderDisabled) {
     try {
         /* Check allocation limits */
         if (Logger::ms_allocationCount >= 32U) {
@@ -104,7 +163,11 @@ Logger::Logger(const std::string& name, const std::string& logFilePath) {
 }
 
 /* Create a non-registering constructor for use in initialize */
-Logger::Logger(std::shared_ptr<spdlog::logger> existingLogger) {
+Logger::Logger(std::shared_ptr<spdlog::logger> existingLogger)
+    : m_deferredFormatting(false),
+      m_maxMessageLength(k_maxMessageLength),
+      m_recordLevel(k_recorderDisabled),
+      m_dumpLevel(k_recorderDisabled) {
     if (!existingLogger) {
         throw std::invalid_argument("Null logger instance provided");
     }
@@ -113,8 +176,193 @@ Logger::Logger(std::shared_ptr<spdlog::logger> existingLogger) {
     /* Note: We don't increment allocation count for wrapper instances */
 }
 
+/* Read asynchronous mode settings for an application from configuration */
+static async::AsyncOptions_t LoadAsyncOptions(const std::string& appName) {
+    auto& config = LogConfig::GetInstance();
+    async::AsyncOptions_t options = async::GetDefaultOptions();
+
+    options.m_enabled = config.GetBool(appName, "async", options.m_enabled);
+
+    const std::int32_t queueSize = config.GetInt32(
+        appName, "queue_size", static_cast<std::int32_t>(options.m_queueSize));
+    if (queueSize > 0) {
+        options.m_queueSize = static_cast<std::uint32_t>(queueSize);
+    }
+
+    const std::int32_t workerThreads =
+        config.GetInt32(appName, "worker_threads",
+                        static_cast<std::int32_t>(options.m_workerThreads));
+    if (workerThreads > 0 &&
+        workerThreads <= static_cast<std::int32_t>(
+                             async::AsyncBackend::k_maxWorkerThreads)) {
+        options.m_workerThreads = static_cast<std::uint8_t>(workerThreads);
+    }
+
+    const std::string policyName =
+        config.GetString(appName, "overflow_policy", "block");
+    if (E_Result::E_SUCCESS !=
+        async::ParseOverflowPolicy(policyName, options.m_overflowPolicy)) {
+        std::cerr << "Warning: Unknown overflow policy '" << policyName
+                  << "', using block" << std::endl;
+    }
+
+    options.m_deferredFormatting = config.GetBool(
+        appName, "deferred_format", options.m_deferredFormatting);
+
+    options.m_perThreadQueues = config.GetBool(appName, "per_thread_queues",
+                                               options.m_perThreadQueues);
+
+    const std::int32_t ringSize = config.GetInt32(
+        appName, "ring_size", static_cast<std::int32_t>(options.m_ringSize));
+    if (ringSize > 0) {
+        options.m_ringSize = static_cast<std::uint32_t>(ringSize);
+    }
+
+    const std::int32_t overflowLevel =
+        config.GetInt32(appName, "overflow_level",
+                        static_cast<std::int32_t>(options.m_dropBelowLevel));
+    if (overflowLevel >= 0 &&
+        overflowLevel <= static_cast<std::int32_t>(E_LogLevel::E_OFF)) {
+        options.m_dropBelowLevel = static_cast<E_LogLevel>(overflowLevel);
+    }
+
+    return options;
+}
+
+/* Replace component level rules with the [component.<name>] sections */
+static void LoadComponentLevels(void) {
+    static const std::string k_sectionPrefix = "component.";
+
+    auto& config = LogConfig::GetInstance();
+    static_cast<void>(ClearComponentLevels());
+
+    std::vector<std::string> sections;
+    if (E_Result::E_SUCCESS !=
+        config.GetSectionNames(k_sectionPrefix, sections)) {
+        return;
+    }
+
+    for (const auto& section : sections) {
+        const std::string component = section.substr(k_sectionPrefix.length());
+        std::string value;
+        std::int32_t level = -1;
+        if (E_Result::E_SUCCESS ==
+            config.GetSectionValue(section, "level", value)) {
+            try {
+                level = std::stoi(value);
+            } catch (...) {
+                level = -1;
+            }
+        }
+
+        if (level < 0 || level > static_cast<std::int32_t>(E_LogLevel::E_OFF) ||
+            E_Result::E_SUCCESS !=
+                ConfigureComponentLevel(component.c_str(),
+                                        static_cast<E_LogLevel>(level))) {
+            std::cerr << "Warning: Invalid level for component '" << component
+                      << "', using the application level" << std::endl;
+        }
+    }
+}
+
+/* Install a named pattern on all loggers */
+static E_Result ApplyPattern(const std::string& patternName,
+                             const std::string& appName) {
+    std::unique_ptr<spdlog::formatter> formatter;
+    const E_Result result =
+        formatters::CreateFormatter(patternName, appName, formatter);
+    if (E_Result::E_SUCCESS != result) {
+        return result;
+    }
+
+    spdlog::set_formatter(std::move(formatter));
+    return E_Result::E_SUCCESS;
+}
+
+/* Apply the pattern and level of a [sink.<name>] section to one output */
+static void ConfigureOutput(const std::string& name,
+                            const std::shared_ptr<spdlog::sinks::sink>& output,
+                            const std::shared_ptr<spdlog::sinks::sink>& fanout,
+                            const std::string& defaultPattern,
+                            const std::string& appName) {
+    if (!output) {
+        return;
+    }
+
+    auto& config = LogConfig::GetInstance();
+    const std::string section = "sink." + name;
+
+    std::string patternName;
+    const bool patternSet = (E_Result::E_SUCCESS ==
+                             config.GetSectionValue(section, "pattern",
+                                                    patternName));
+    if (!patternSet) {
+        patternName = defaultPattern;
+    }
+
+    std::unique_ptr<spdlog::formatter> formatter;
+    if ((E_Result::E_SUCCESS !=
+         formatters::CreateFormatter(patternName, appName, formatter)) ||
+        (E_Result::E_SUCCESS != sinks::SetOutputFormatter(
+                                    fanout, output, std::move(formatter),
+                                    patternName))) {
+        if (patternSet) {
+            std::cerr << "Warning: Invalid pattern for sink '" << name
+                      << "', using the application pattern" << std::endl;
+        }
+    }
+
+    std::string value;
+    if (E_Result::E_SUCCESS !=
+        config.GetSectionValue(section, "level", value)) {
+        return;
+    }
+    std::int32_t level = -1;
+    try {
+        level = std::stoi(value);
+    } catch (...) {
+        level = -1;
+    }
+    if ((level < 0) || (level > static_cast<std::int32_t>(E_LogLevel::E_OFF))) {
+        std::cerr << "Warning: Invalid level for sink '" << name
+                  << "', accepting all levels" << std::endl;
+        return;
+    }
+    output->set_level(static_cast<spdlog::level::level_enum>(level));
+
+    /* A sink level only filters what the component levels let through */
+    const std::int32_t floor =
+        static_cast<std::int32_t>(GetComponentLevelFloor());
+    if (level < floor) {
+        std::cerr << "Warning: Level for sink '" << name
+                  << "' is below log_level and every component level, "
+                  << "records below level " << floor << " never reach it"
+                  << std::endl;
+    }
+}
+
+/* Apply the [sink.<name>] sections to all outputs; syslog adds its own
+ * header, so it defaults to the minimal pattern */
+static void ConfigureOutputs(const ConfiguredOutputs_t& outputs,
+                             const std::string& patternName,
+                             const std::string& appName) {
+    ConfigureOutput("console", outputs.m_console, outputs.m_fanout,
+                    patternName, appName);
+    ConfigureOutput("file", outputs.m_file, outputs.m_fanout, patternName,
+                    appName);
+    ConfigureOutput("syslog", outputs.m_syslog, outputs.m_fanout, "minimal",
+                    appName);
+}
+
 E_Result Logger::Initialize(const std::string& appName,
                             const std::string& logDir, E_LogLevel level) {
+    /* Asynchronous mode is taken from configuration */
+    return Initialize(appName, logDir, level, LoadAsyncOptions(appName));
+}
+
+E_Result Logger::Initialize(const std::string& appName,
+                            const std::string& logDir, E_LogLevel level,
+                            const async::AsyncOptions_t& asyncOptions) {
     /* Thread synchronization for singleton initialization */
     std::lock_guard<std::mutex> lock(g_loggerMutex);
 
@@ -154,6 +402,41 @@ E_Result Logger::Initialize(const std::string& appName,
         const std::int32_t fileMaxCount =
             config.GetInt32(appName, "max_files", 5);
 
+        /* Window for collapsing repeated records, 0 disables */
+        const std::int32_t dedupWindowMs =
+            config.GetInt32(appName, "dedup_window_ms", 0);
+
+        /* Memory-mapped ring surviving a crash, size in bytes, 0 disables */
+        const std::int32_t crashRingSize =
+            config.GetInt32(appName, "crash_ring_size", 0);
+        const std::string crashRingFile = config.GetString(
+            appName, "crash_ring_file",
+            configuredLogDir + "/" + appName + "/" + appName + ".ring");
+
+        /* Ring of records below the active level, 0 disables */
+        const std::int32_t recorderSize =
+            config.GetInt32(appName, "flight_recorder_size", 0);
+        const std::int32_t recorderLevel = config.GetInt32(
+            appName, "flight_recorder_level",
+            static_cast<std::int32_t>(E_LogLevel::E_TRACE));
+        const std::int32_t recorderTrigger = config.GetInt32(
+            appName, "flight_recorder_trigger",
+            static_cast<std::int32_t>(E_LogLevel::E_ERROR));
+
+        /* Interval between timer summaries, 0 reports at shutdown only */
+        const std::int32_t timerReportMs = config.GetInt32(
+            appName, "timer_report_ms",
+            static_cast<std::int32_t>(k_defaultTimerReportMs));
+
+        /* Timestamp source of the records */
+        const std::string clockName =
+            config.GetString(appName, "clock_source", "system");
+
+        /* Formatted message limit */
+        const std::int32_t maxMessageLength = config.GetInt32(
+            appName, "max_message_length",
+            static_cast<std::int32_t>(Logger::k_maxMessageLength));
+
         /* Convert level from config if provided */
         const E_LogLevel configuredLevel =
             static_cast<E_LogLevel>(config.GetInt32(
@@ -176,48 +459,97 @@ E_Result Logger::Initialize(const std::string& appName,
                 configuredLogDir + "/" + appName + "/" + appName + ".log";
         }
 
+        /* Destinations that receive formatted output */
+        std::vector<std::shared_ptr<spdlog::sinks::sink>> outputSinks;
+
+        /* Outputs configured by [sink.<name>] sections, and their fan-out */
+        std::shared_ptr<spdlog::sinks::sink> consoleOutput;
+        std::shared_ptr<spdlog::sinks::sink> fileOutput;
+        std::shared_ptr<spdlog::sinks::sink> syslogOutput;
+        std::shared_ptr<spdlog::sinks::sink> fanoutOutput;
+
         /* Check if a logger with this name already exists */
         auto existingLogger = spdlog::get(appName);
         if (existingLogger) {
             /* Use the existing logger, just update its configuration */
             ms_defaultInstance = std::make_shared<Logger>(existingLogger);
+            PublishDefaultInstance();
+            outputSinks = existingLogger->sinks();
+
+            /* Its sinks are kept, settings that build sinks cannot apply */
+            std::vector<std::string> sinkSections;
+            static_cast<void>(config.GetSectionNames("sink.", sinkSections));
+            if (asyncOptions.m_enabled || (dedupWindowMs > 0) ||
+                (crashRingSize > 0) || !sinkSections.empty()) {
+                std::cerr << "Warning: Logger '" << appName
+                          << "' already exists, its async, dedup_window_ms, "
+                             "crash_ring_size and [sink.*] settings are "
+                             "ignored"
+                          << std::endl;
+            }
+
+            /* Configure colors of a console sink made by spdlog */
+            if (useColors && useConsole) {
+                for (auto& sink : outputSinks) {
+                    auto consoleSink = std::dynamic_pointer_cast<
+                        spdlog::sinks::stdout_color_sink_mt>(sink);
+
+                    if (consoleSink) {
+                        /* Cyan, bright green, bright white, bright yellow,
+                         * bright red, white on red */
+                        consoleSink->set_color(spdlog::level::trace,
+                                               "\033[36m");
+                        consoleSink->set_color(spdlog::level::debug,
+                                               "\033[92m");
+                        consoleSink->set_color(spdlog::level::info,
+                                               "\033[97m");
+                        consoleSink->set_color(spdlog::level::warn,
+                                               "\033[93m");
+                        consoleSink->set_color(spdlog::level::err,
+                                               "\033[91m");
+                        consoleSink->set_color(spdlog::level::critical,
+                                               "\033[97;41m");
+                        break; /* Only configure the first console sink */
+                    }
+                }
+            }
         } else {
             /* Build a vector of sinks based on configuration */
             std::vector<std::shared_ptr<spdlog::sinks::sink>> sinkVec;
 
             /* Add console sink if configured */
             if (useConsole) {
-                auto consoleSink = sinks::CreateConsoleSink(useColors);
-                if (consoleSink) {
-                    sinkVec.push_back(consoleSink);
+                consoleOutput = sinks::CreateConsoleSink(useColors);
+                if (consoleOutput) {
+                    sinkVec.push_back(consoleOutput);
                 }
             }
 
             /* Add file sink if configured */
             if (useFile && !logFilePath.empty()) {
-                auto fileSink = sinks::CreateFileSink(
+                fileOutput = sinks::CreateFileSink(
                     logFilePath, true, static_cast<std::size_t>(fileMaxSize),
                     static_cast<std::size_t>(fileMaxCount));
 
-                if (fileSink) {
-                    sinkVec.push_back(fileSink);
+                if (fileOutput) {
+                    sinkVec.push_back(fileOutput);
                 }
             }
 
             /* Add syslog sink if configured */
             if (useSyslog) {
-                auto syslogSink =
+                syslogOutput =
                     sinks::CreateSyslogSink("vsnlogger", 0, 0, true);
-                if (syslogSink) {
-                    sinkVec.push_back(syslogSink);
+                if (syslogOutput) {
+                    sinkVec.push_back(syslogOutput);
                 }
             }
 
             /* If no sinks were added, add a default console sink */
             if (sinkVec.empty()) {
-                auto defaultSink = sinks::CreateConsoleSink(useColors);
-                if (defaultSink) {
-                    sinkVec.push_back(defaultSink);
+                consoleOutput = sinks::CreateConsoleSink(useColors);
+                if (consoleOutput) {
+                    sinkVec.push_back(consoleOutput);
                 }
             }
 
@@ -226,10 +558,62 @@ E_Result Logger::Initialize(const std::string& appName,
                                               ? sinkVec.size()
                                               : Logger::k_maxSinks;
 
+            outputSinks.assign(
+                sinkVec.begin(),
+                sinkVec.begin() + static_cast<int32_t>(sinkCount));
+
+            /* Format each record once for destinations sharing a pattern */
+            if (outputSinks.size() > 1U) {
+                fanoutOutput = sinks::CreateFanoutSink(outputSinks);
+                if (fanoutOutput) {
+                    outputSinks.assign(1U, fanoutOutput);
+                }
+            }
+
+            /* Collapse repeated records in front of the destinations */
+            if (dedupWindowMs > 0) {
+                auto dedupSink = sinks::CreateDedupSink(
+                    outputSinks, static_cast<std::uint32_t>(dedupWindowMs));
+                if (dedupSink) {
+                    outputSinks.assign(1U, dedupSink);
+                }
+            }
+
+            /* The crash ring sits beside the other outputs, without
+             * dedup: in asynchronous mode the writer threads fill it after
+             * decoding, like every other sink */
+            if (crashRingSize > 0) {
+                auto crashSink = sinks::CreateCrashRingSink(
+                    crashRingFile, static_cast<std::uint64_t>(crashRingSize));
+                if (crashSink &&
+                    (E_Result::E_SUCCESS == crash::InstallCrashHandler())) {
+                    outputSinks.push_back(crashSink);
+                } else {
+                    std::cerr << "Warning: Failed to create crash ring "
+                              << crashRingFile << std::endl;
+                }
+            }
+
+            /* Put the asynchronous backend in front of the sinks if enabled */
+            std::shared_ptr<async::AsyncBackend> asyncBackend;
+            if (asyncOptions.m_enabled) {
+                asyncBackend = std::make_shared<async::AsyncBackend>(
+                    appName, outputSinks, asyncOptions);
+
+                auto asyncSink = sinks::CreateAsyncSink(asyncBackend);
+                if (!asyncSink ||
+                    E_Result::E_SUCCESS != asyncBackend->Start()) {
+                    return E_Result::E_RESOURCE_UNAVAILABLE;
+                }
+
+                sinkVec.assign(1U, asyncSink);
+            } else {
+                sinkVec = outputSinks;
+            }
+
             /* Create logger with the sinks */
             auto logger = std::make_shared<spdlog::logger>(
-                appName, sinkVec.begin(),
-                sinkVec.begin() + static_cast<int32_t>(sinkCount));
+                appName, sinkVec.begin(), sinkVec.end());
 
             if (!logger) {
                 return E_Result::E_ALLOCATION_FAILED;
@@ -240,50 +624,68 @@ E_Result Logger::Initialize(const std::string& appName,
 
             /* Create our wrapper without re-registering */
             ms_defaultInstance = std::make_shared<Logger>(logger);
+            ms_defaultInstance->m_asyncBackend = asyncBackend;
+            ms_defaultInstance->m_deferredFormatting =
+                asyncBackend && asyncOptions.m_deferredFormatting;
+            PublishDefaultInstance();
         }
 
-        /* Set pattern using formatter helper */
-        std::string pattern;
-        const E_Result patternResult =
-            formatters::GetPattern(patternName, pattern);
+        if ((maxMessageLength <= 0) ||
+            (E_Result::E_SUCCESS !=
+             ms_defaultInstance->SetMaxMessageLength(
+                 static_cast<std::uint32_t>(maxMessageLength)))) {
+            std::cerr << "Warning: Invalid max_message_length "
+                      << maxMessageLength << ", using "
+                      << Logger::k_maxMessageLength << std::endl;
+        }
 
-        if (E_Result::E_SUCCESS == patternResult && !pattern.empty()) {
-            spdlog::set_pattern(pattern);
-        } else {
+        if ((recorderSize > 0) &&
+            ((recorderLevel < 0) ||
+             (recorderLevel > static_cast<std::int32_t>(E_LogLevel::E_OFF)) ||
+             (recorderTrigger < 0) ||
+             (recorderTrigger > static_cast<std::int32_t>(E_LogLevel::E_OFF)) ||
+             (E_Result::E_SUCCESS !=
+              ms_defaultInstance->EnableFlightRecorder(
+                  static_cast<std::uint32_t>(recorderSize),
+                  static_cast<E_LogLevel>(recorderLevel),
+                  static_cast<E_LogLevel>(recorderTrigger))))) {
+            std::cerr << "Warning: Invalid flight recorder settings, "
+                      << "flight recorder disabled" << std::endl;
+        }
+
+        if (timerReportMs >= 0) {
+            static_cast<void>(SetTimerReportInterval(
+                static_cast<std::uint32_t>(timerReportMs)));
+        }
+
+        E_ClockSource clockSource = E_ClockSource::E_SYSTEM;
+        if ((E_Result::E_SUCCESS !=
+             ParseClockSource(clockName, clockSource)) ||
+            (E_Result::E_SUCCESS != SetClockSource(clockSource))) {
+            std::cerr << "Warning: Clock source '" << clockName
+                      << "' unavailable, keeping the current source"
+                      << std::endl;
+        }
+
+        /* Set pattern using formatter helper */
+        if (E_Result::E_SUCCESS != ApplyPattern(patternName, appName)) {
             /* Default pattern if formatter failed */
             spdlog::set_pattern(
                 "%Y-%m-%d %H:%M:%S.%f %z  [%^%-8l%$] [%-10n] [%-5P %-5t] "
                 "[%g:%#] %v");
         }
 
-        /* Set level */
-        spdlog::set_level(
-            static_cast<spdlog::level::level_enum>(configuredLevel));
-
-        /* Configure colors for console sinks if using an existing logger */
-        if (useColors && useConsole) {
-            auto sinks = ms_defaultInstance->m_logger->sinks();
-            for (auto& sink : sinks) {
-                auto consoleSink = std::dynamic_pointer_cast<
-                    spdlog::sinks::stdout_color_sink_mt>(sink);
-
-                if (consoleSink) {
-                    consoleSink->set_color(spdlog::level::trace,
-                                           "\033[36m"); /* Cyan */
-                    consoleSink->set_color(spdlog::level::debug,
-                                           "\033[92m"); /* Bright Green */
-                    consoleSink->set_color(spdlog::level::info,
-                                           "\033[97m"); /* Bright White */
-                    consoleSink->set_color(spdlog::level::warn,
-                                           "\033[93m"); /* Bright Yellow */
-                    consoleSink->set_color(spdlog::level::err,
-                                           "\033[91m"); /* Bright Red */
-                    consoleSink->set_color(spdlog::level::critical,
-                                           "\033[97;41m"); /* White on Red */
-                    break; /* Only configure the first console sink */
-                }
-            }
-        }
+        /* Set level, opening the backend down to the lowest component */
+        LoadComponentLevels();
+        static_cast<void>(ConfigureDefaultLevel(configuredLevel));
+        spdlog::set_level(static_cast<spdlog::level::level_enum>(
+            GetComponentLevelFloor()));
+        PublishLevelFloor();
+
+        /* Per-output patterns and levels, checked against the levels */
+        g_outputs = ConfiguredOutputs_t{consoleOutput, fileOutput,
+                                        syslogOutput, fanoutOutput};
+        ConfigureOutputs(g_outputs, patternName, appName);
 
         /* Log initialization message */
         ms_defaultInstance->Info(
@@ -298,13 +700,28 @@ E_Result Logger::Initialize(const std::string& appName,
 }
 
 std::shared_ptr<Logger>& Logger::GetDefaultLogger(void) {
-    /* Thread synchronization for singleton access */
+    /* Lock-free fast path: reuse this thread's handle while the published
+     * generation is unchanged */
+    const std::uint64_t generation =
+        g_defaultGeneration.load(std::memory_order_acquire);
+    DefaultLoggerCache_t& cache = t_defaultLoggerCache;
+    if (generation == cache.m_generation) {
+        return *cache.m_handle;
+    }
+
+    return RefreshDefaultLogger();
+}
+
+std::shared_ptr<Logger>& Logger::RefreshDefaultLogger(void) {
+    /* Refresh the cached handle under the singleton mutex */
     std::lock_guard<std::mutex> lock(g_loggerMutex);
 
     if (!ms_defaultInstance) {
         /* If not initialized yet, create a temporary default logger */
         try {
             ms_defaultInstance = std::make_shared<Logger>("default");
+            PublishDefaultInstance();
+            PublishLevelFloor();
             ms_defaultInstance->Warn(
                 SourceLocation_t{"logger.cpp", __LINE__, __func__},
                 "Using uninitialized default logger. Call VSN_INIT_LOGGING "
@@ -316,32 +733,85 @@ std::shared_ptr<Logger>& Logger::GetDefaultLogger(void) {
             return emergencyLogger;
         }
     }
+
+    /* Generation and instance are only modified under the mutex */
+    t_defaultLoggerCache.m_handle = &ms_defaultInstance;
+    t_defaultLoggerCache.m_generation =
+        g_defaultGeneration.load(std::memory_order_relaxed);
     return ms_defaultInstance;
 }
 
+void Logger::PublishLevelFloor(void) {
+    std::uint8_t floor = 0U;
+    if (ms_defaultInstance) {
+        floor = std::min(
+            static_cast<std::uint8_t>(GetComponentLevelFloor()),
+            ms_defaultInstance->m_recordLevel.load(std::memory_order_acquire));
+    }
+    ms_levelFloor.store(floor, std::memory_order_relaxed);
+}
+
+void Logger::LowerLevelFloor(std::uint8_t level) {
+    std::uint8_t floor = ms_levelFloor.load(std::memory_order_relaxed);
+    while ((level < floor) &&
+           !ms_levelFloor.compare_exchange_weak(floor, level,
+                                                std::memory_order_relaxed)) {
+    }
+}
+
 E_Result Logger::SetPattern(const std::string& patternName) {
     try {
-        std::string pattern;
-        const E_Result result = formatters::GetPattern(patternName, pattern);
+        std::string appName;
+        ConfiguredOutputs_t outputs;
+        {
+            std::lock_guard<std::mutex> lock(g_loggerMutex);
+            if (ms_defaultInstance && ms_defaultInstance->m_logger) {
+                appName = ms_defaultInstance->m_logger->name();
+            }
+            outputs = g_outputs;
+        }
 
-        if (E_Result::E_SUCCESS != result) {
-            return result;
+        const E_Result result = ApplyPattern(patternName, appName);
+        if (E_Result::E_SUCCESS == result) {
+            /* Outputs with a pattern of their own get it back */
+            ConfigureOutputs(outputs, patternName, appName);
         }
+        return result;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
 
-        if (pattern.empty()) {
-            return E_Result::E_INVALID_PARAMETER;
+E_Result Logger::SetLevel(E_LogLevel level) {
+    try {
+        const E_Result result = ConfigureDefaultLevel(level);
+        if (E_Result::E_SUCCESS != result) {
+            return result;
         }
 
-        spdlog::set_pattern(pattern);
+        std::lock_guard<std::mutex> lock(g_loggerMutex);
+        spdlog::set_level(static_cast<spdlog::level::level_enum>(
+            GetComponentLevelFloor()));
+        PublishLevelFloor();
         return E_Result::E_SUCCESS;
     } catch (...) {
         return E_Result::E_UNKNOWN_ERROR;
     }
 }
 
-E_Result Logger::SetLevel(E_LogLevel level) {
+E_Result Logger::SetComponentLevel(const std::string& component,
+                                   E_LogLevel level) {
     try {
-        spdlog::set_level(static_cast<spdlog::level::level_enum>(level));
+        const E_Result result =
+            ConfigureComponentLevel(component.c_str(), level);
+        if (E_Result::E_SUCCESS != result) {
+            return result;
+        }
+
+        std::lock_guard<std::mutex> lock(g_loggerMutex);
+        spdlog::set_level(static_cast<spdlog::level::level_enum>(
+            GetComponentLevelFloor()));
+        PublishLevelFloor();
         return E_Result::E_SUCCESS;
     } catch (...) {
         return E_Result::E_UNKNOWN_ERROR;
@@ -350,9 +820,7 @@ E_Result Logger::SetLevel(E_LogLevel level) {
 
 E_Result Logger::InitializeWithConfig(const std::string& appName,
                                       const std::string& configFile) {
-    /* Thread synchronization for singleton initialization */
-    std::lock_guard<std::mutex> lock(g_loggerMutex);
-
+    /* No singleton lock here: Initialize() below acquires it itself */
     try {
         /* Input validation */
         if (appName.empty()) {
@@ -406,10 +874,162 @@ E_Result Logger::Flush(void) {
     }
 }
 
+E_Result Logger::PrepareThread(void) {
+    try {
+        /* Touch thread-local buffers so their storage is set up now */
+        static_cast<void>(detail::MessageBuffer());
+        static_cast<void>(async::detail::StagingRecord());
+        static_cast<void>(async::detail::ThreadId());
+
+        return m_asyncBackend ? m_asyncBackend->PrepareThread()
+                              : E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_Result Logger::SetMaxMessageLength(std::uint32_t length) {
+    if ((length <= k_truncationMarkerLength) || (length > k_maxMessageBuffer)) {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    m_maxMessageLength.store(length, std::memory_order_relaxed);
+    if (m_asyncBackend) {
+        /* Deferred records are formatted by the backend */
+        m_asyncBackend->SetMaxMessageLength(length);
+    }
+
+    return E_Result::E_SUCCESS;
+}
+
+std::uint32_t Logger::GetMaxMessageLength(void) const {
+    return m_maxMessageLength.load(std::memory_order_relaxed);
+}
+
+E_Result Logger::EnableFlightRecorder(std::uint32_t capacity,
+                                      E_LogLevel level, E_LogLevel trigger) {
+    if ((0U == capacity) || (capacity > FlightRecorder::k_maxCapacity) ||
+        (level > E_LogLevel::E_OFF) || (trigger > E_LogLevel::E_OFF)) {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    try {
+        std::lock_guard<std::mutex> lock(g_recorderMutex);
+
+        if (!m_recorder) {
+            m_recorder.reset(new FlightRecorder(capacity));
+        } else if (m_recorder->GetCapacity() != capacity) {
+            /* Producers may hold the ring, it is never replaced */
+            return E_Result::E_INVALID_STATE;
+        }
+
+        m_recordLevel.store(static_cast<std::uint8_t>(level),
+                            std::memory_order_release);
+        m_dumpLevel.store(static_cast<std::uint8_t>(trigger),
+                          std::memory_order_relaxed);
+
+        /* Initialize() calls this with the singleton mutex held, so the
+         * floor is only lowered here */
+        LowerLevelFloor(static_cast<std::uint8_t>(level));
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_Result Logger::DisableFlightRecorder(void) {
+    try {
+        m_recordLevel.store(k_recorderDisabled, std::memory_order_release);
+        m_dumpLevel.store(k_recorderDisabled, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(g_loggerMutex);
+        PublishLevelFloor();
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_Result Logger::DumpFlightRecorder(void) {
+    try {
+        if (!m_logger) {
+            return E_Result::E_NOT_INITIALIZED;
+        }
+
+        std::lock_guard<std::mutex> lock(g_recorderMutex);
+        if (!m_recorder) {
+            return E_Result::E_INVALID_STATE;
+        }
+
+        return m_recorder->Dump(
+            *m_logger, m_asyncBackend.get(),
+            m_maxMessageLength.load(std::memory_order_relaxed));
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_Result Logger::EnqueueDeferred(const async::AsyncRecord_t& record) {
+    if (!m_asyncBackend) {
+        return E_Result::E_NOT_INITIALIZED;
+    }
+
+    return m_asyncBackend->Enqueue(record);
+}
+
+E_Result Logger::EmitKv(const async::AsyncRecord_t& record) {
+    const std::size_t limit =
+        m_maxMessageLength.load(std::memory_order_relaxed);
+
+    /* Context captured before a failure goes out ahead of it */
+    if (static_cast<std::uint8_t>(record.m_level) >=
+        m_dumpLevel.load(std::memory_order_relaxed)) {
+        static_cast<void>(DumpFlightRecorder());
+    }
+
+    if (m_asyncBackend) {
+        return m_asyncBackend->Enqueue(record);
+    }
+
+    /* Render the text once, formatters find the typed fields in context */
+    const spdlog::string_view_t payload =
+        async::RenderRecord(record, limit, t_kvScratch);
+    detail::KvContext_t context;
+    const detail::KvScope_t scope(
+        detail::BindKvContext(record, payload.data(), context));
+    m_logger->log(detail::ClockTicksToTime(record.m_ticks), record.m_source,
+                  record.m_level, payload);
+    return E_Result::E_SUCCESS;
+}
+
+E_Result Logger::GetAsyncStats(async::AsyncStats_t& stats) const {
+    if (!m_asyncBackend) {
+        return E_Result::E_INVALID_STATE;
+    }
+
+    stats = m_asyncBackend->GetStats();
+    return E_Result::E_SUCCESS;
+}
+
 E_Result Logger::Shutdown(void) {
+    /* Thread synchronization for singleton teardown */
+    std::lock_guard<std::mutex> lock(g_loggerMutex);
+
     try {
+        /* Summaries of the last timer interval */
+        if (ms_defaultInstance) {
+            static_cast<void>(ReportTimers(*ms_defaultInstance));
+        }
+
+        /* Flushing drains the asynchronous queue before writers stop */
         spdlog::shutdown();
+        if (ms_defaultInstance && ms_defaultInstance->m_asyncBackend) {
+            static_cast<void>(ms_defaultInstance->m_asyncBackend->Stop());
+        }
         ms_defaultInstance = nullptr;
+        g_outputs = ConfiguredOutputs_t{};
+        PublishDefaultInstance();
+        PublishLevelFloor();
         return E_Result::E_SUCCESS;
     } catch (...) {
         return E_Result::E_UNKNOWN_ERROR;
@@ -0,0 +1,114 @@
+/**
+ * @file recorder.cpp
+ * @brief Implementation of the flight recorder for VSNLogger
+ *
+ * @details
+ * Producers claim a capture number with one atomic increment and copy
+ * their record into the slot it maps to. The slot stores the capture
+ * number, so a dump can tell a slot overwritten by a newer capture from
+ * the record it expected and skips it rather than writing it out of order.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include "vsnlogger/recorder.h"
+
+#include <spdlog/details/log_msg.h>
+#include <spdlog/sinks/sink.h>
+
+#include <thread>
+
+#include "vsnlogger/async.h"
+#include "vsnlogger/logger.h"
+
+namespace vsn {
+namespace logger {
+
+/* Take the spin lock of a slot */
+static void LockSlot(std::atomic<bool>& busy) {
+    while (busy.exchange(true, std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+FlightRecorder::FlightRecorder(std::uint32_t capacity)
+    : m_slots(new Slot_t[capacity]),
+      m_capacity(capacity),
+      m_next(0U),
+      m_dumped(0U) {}
+
+void FlightRecorder::Store(const async::AsyncRecord_t& record) {
+    const std::uint64_t ticket =
+        m_next.fetch_add(1U, std::memory_order_relaxed);
+    Slot_t& slot = m_slots[ticket % m_capacity];
+
+    LockSlot(slot.m_busy);
+    async::CopyRecord(record, slot.m_record);
+    slot.m_ticket = ticket + 1U;
+    slot.m_busy.store(false, std::memory_order_release);
+}
+
+E_Result FlightRecorder::Dump(spdlog::logger& logger,
+                              async::AsyncBackend* backend,
+                              std::size_t limit) {
+    try {
+        std::lock_guard<std::mutex> lock(m_dumpMutex);
+
+        const std::uint64_t end = m_next.load(std::memory_order_relaxed);
+        const std::uint64_t start =
+            std::max(m_dumped, (end > m_capacity) ? (end - m_capacity) : 0U);
+        m_dumped = end;
+
+        async::AsyncRecord_t record;
+        spdlog::memory_buf_t scratch;
+        E_Result result = E_Result::E_SUCCESS;
+
+        for (std::uint64_t ticket = start; ticket < end; ++ticket) {
+            Slot_t& slot = m_slots[ticket % m_capacity];
+
+            /* Skip slots still being written or already reused */
+            LockSlot(slot.m_busy);
+            const bool current = (slot.m_ticket == ticket + 1U);
+            if (current) {
+                async::CopyRecord(slot.m_record, record);
+            }
+            slot.m_busy.store(false, std::memory_order_release);
+            if (!current) {
+                continue;
+            }
+
+            if (nullptr != backend) {
+                /* Writer threads render the record like any other */
+                if (E_Result::E_SUCCESS != backend->Enqueue(record)) {
+                    result = E_Result::E_RESOURCE_UNAVAILABLE;
+                }
+                continue;
+            }
+
+            spdlog::details::log_msg msg(
+                detail::ClockTicksToTime(record.m_ticks), record.m_source,
+                logger.name(), record.m_level,
+                async::RenderRecord(record, limit, scratch));
+            msg.thread_id = record.m_threadId;
+
+            for (const auto& destination : logger.sinks()) {
+                try {
+                    if (destination->should_log(msg.level)) {
+                        destination->log(msg);
+                    }
+                } catch (...) {
+                    /* A failing sink must not stop the other sinks */
+                    result = E_Result::E_UNKNOWN_ERROR;
+                }
+            }
+        }
+
+        return result;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+} /* namespace logger */
+} /* namespace vsn */
@@ -13,16 +13,26 @@
 
 #include "vsnlogger/sinks.h"
 
-#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/details/console_globals.h>
+#include <spdlog/details/os.h>
+#include <spdlog/pattern_formatter.h>
+#include <spdlog/sinks/base_sink.h>
 #include <spdlog/sinks/null_sink.h>
 #include <spdlog/sinks/rotating_file_sink.h>
-#include <spdlog/sinks/stdout_color_sinks.h>
-#include <spdlog/sinks/stdout_sinks.h>
 #include <spdlog/sinks/syslog_sink.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
 #include <mutex>
+#include <stdexcept>
+
+#include "vsnlogger/async.h"
+#include "vsnlogger/crash.h"
+#include "vsnlogger/format.h"
 
 namespace vsn {
 namespace logger {
@@ -37,6 +47,709 @@ static std::atomic<std::uint32_t> g_sinkAllocationCount(0U);
 /* Maximum number of sink allocations allowed */
 static constexpr std::uint32_t k_maxSinkAllocations = 64U;
 
+/* Formatting buffer reserved per sink: longest message plus pattern text */
+static constexpr std::size_t k_sinkBufferReserve = k_maxMessageBuffer + 512U;
+
+/* Size of the stdio buffer owned by each file sink */
+static constexpr std::size_t k_fileBufferSize = 64U * 1024U;
+
+/* Console colors by level, trace to off */
+static const char* const k_consoleColors[] = {
+    "\033[36m",    /* Cyan */
+    "\033[92m",    /* Bright Green */
+    "\033[97m",    /* Bright White */
+    "\033[93m",    /* Bright Yellow */
+    "\033[91m",    /* Bright Red */
+    "\033[97;41m", /* White on Red */
+    ""};
+
+/* Console color reset sequence */
+static const char k_consoleReset[] = "\033[m";
+
+/* Longest color sequence plus the reset sequence */
+static constexpr std::size_t k_maxColorLength = 16U;
+
+/**
+ * @brief Sink formatting into a buffer reserved at construction
+ *
+ * @details
+ * spdlog's own sinks format each record into a stack buffer that spills
+ * to the heap for long lines. Reusing one member buffer under the sink lock
+ * keeps steady-state logging free of heap allocation.
+ */
+class BufferedSink : public spdlog::sinks::base_sink<std::mutex> {
+   public:
+    BufferedSink(void) { m_buffer.reserve(k_sinkBufferReserve); }
+
+    /**
+     * @brief Write a record already formatted by a fan-out sink
+     *
+     * @param[in] msg Record, for level and color range
+     * @param[in] text Formatted record
+     */
+    void WriteText(const spdlog::details::log_msg& msg,
+                   const spdlog::memory_buf_t& text) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        WriteFormatted(msg, text);
+    }
+
+   protected:
+    void sink_it_(const spdlog::details::log_msg& msg) final {
+        m_buffer.clear();
+        formatter_->format(msg, m_buffer);
+        WriteFormatted(msg, m_buffer);
+    }
+
+    /**
+     * @brief Write one formatted record, called with the sink lock held
+     *
+     * @param[in] msg Record, for level and color range
+     * @param[in] text Formatted record
+     */
+    virtual void WriteFormatted(const spdlog::details::log_msg& msg,
+                                const spdlog::memory_buf_t& text) = 0;
+
+   private:
+    /** Formatting buffer reused for every record */
+    spdlog::memory_buf_t m_buffer;
+};
+
+/**
+ * @brief Standard output sink with optional level colors
+ *
+ * @details
+ * Like spdlog's console sinks, writes hold spdlog's process-wide console
+ * mutex, and a colored record is assembled first and written with one
+ * fwrite(), so records from other console sinks cannot split it.
+ */
+class ConsoleSink final : public BufferedSink {
+   public:
+    explicit ConsoleSink(bool colored)
+        : m_colored(colored && spdlog::details::os::in_terminal(stdout) &&
+                    spdlog::details::os::is_color_terminal()) {
+        if (m_colored) {
+            m_line.reserve(k_sinkBufferReserve + k_maxColorLength);
+        }
+    }
+
+   protected:
+    void WriteFormatted(const spdlog::details::log_msg& msg,
+                        const spdlog::memory_buf_t& text) override {
+        const char* data = text.data();
+        std::size_t size = text.size();
+        const std::size_t start = msg.color_range_start;
+        const std::size_t end = msg.color_range_end;
+
+        if (m_colored && (end > start) && (end <= size)) {
+            const char* const color =
+                k_consoleColors[static_cast<std::size_t>(msg.level)];
+            m_line.clear();
+            m_line.append(data, data + start);
+            m_line.append(color, color + std::strlen(color));
+            m_line.append(data + start, data + end);
+            m_line.append(k_consoleReset,
+                          k_consoleReset + (sizeof(k_consoleReset) - 1U));
+            m_line.append(data + end, data + size);
+            data = m_line.data();
+            size = m_line.size();
+        }
+
+        std::lock_guard<spdlog::details::console_mutex::mutex_t> lock(
+            spdlog::details::console_mutex::mutex());
+        std::fwrite(data, 1U, size, stdout);
+    }
+
+    void flush_() override {
+        std::lock_guard<spdlog::details::console_mutex::mutex_t> lock(
+            spdlog::details::console_mutex::mutex());
+        std::fflush(stdout);
+    }
+
+   private:
+    /** Emit color sequences around the level */
+    const bool m_colored;
+
+    /** Colored record assembled for a single write */
+    spdlog::memory_buf_t m_line;
+};
+
+/**
+ * @brief Append-mode file sink with optional size-based rotation
+ *
+ * @details
+ * Rotated file names are computed at construction and the stdio buffer is
+ * owned by the sink, so rotation renames files and reopens the stream in
+ * place without allocating. Naming follows spdlog's rotating sink
+ * (app.log, app.1.log, ...).
+ */
+class FileSink final : public BufferedSink {
+   public:
+    FileSink(const std::string& filename, std::size_t maxSize,
+             std::size_t maxFiles)
+        : m_maxSize(maxSize),
+          m_currentSize(0U),
+          m_file(nullptr),
+          m_fileBuffer(new char[k_fileBufferSize]) {
+        const std::size_t names = (maxSize > 0U) ? (maxFiles + 1U) : 1U;
+        m_names.reserve(names);
+        for (std::size_t i = 0U; i < names; ++i) {
+            m_names.push_back(
+                spdlog::sinks::rotating_file_sink_mt::calc_filename(filename,
+                                                                    i));
+        }
+
+        m_file = std::fopen(m_names[0].c_str(), "ab");
+        if (nullptr == m_file) {
+            throw std::runtime_error("Failed to open log file");
+        }
+        static_cast<void>(std::setvbuf(m_file, m_fileBuffer.get(), _IOFBF,
+                                       k_fileBufferSize));
+
+        /* Continue counting from the size of an existing file */
+        if (0 == std::fseek(m_file, 0, SEEK_END)) {
+            const long position = std::ftell(m_file);
+            m_currentSize =
+                (position > 0) ? static_cast<std::size_t>(position) : 0U;
+        }
+    }
+
+    ~FileSink(void) override {
+        if (nullptr != m_file) {
+            static_cast<void>(std::fclose(m_file));
+        }
+    }
+
+    /* Disable copy and assignment */
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+   protected:
+    void WriteFormatted(const spdlog::details::log_msg& msg,
+                        const spdlog::memory_buf_t& text) override {
+        static_cast<void>(msg);
+
+        if ((m_maxSize > 0U) && (m_currentSize > 0U) &&
+            ((m_currentSize + text.size()) > m_maxSize)) {
+            Rotate();
+        }
+
+        if (nullptr == m_file) {
+            return;
+        }
+
+        if (std::fwrite(text.data(), 1U, text.size(), m_file) != text.size()) {
+            throw spdlog::spdlog_ex("Failed writing to log file");
+        }
+        m_currentSize += text.size();
+    }
+
+    void flush_() override {
+        if (nullptr != m_file) {
+            static_cast<void>(std::fflush(m_file));
+        }
+    }
+
+   private:
+    /* Shift app.N-1.log to app.N.log down to app.log, then truncate */
+    void Rotate(void) {
+        static_cast<void>(std::fflush(m_file));
+
+        for (std::size_t i = m_names.size() - 1U; i > 0U; --i) {
+            if (!spdlog::details::os::path_exists(m_names[i - 1U])) {
+                continue;
+            }
+            static_cast<void>(std::remove(m_names[i].c_str()));
+            static_cast<void>(
+                std::rename(m_names[i - 1U].c_str(), m_names[i].c_str()));
+        }
+
+        /* Reopen in place; the file is truncated even if a rename failed so
+         * it cannot grow past its limit */
+        m_file = std::freopen(m_names[0].c_str(), "wb", m_file);
+        if (nullptr != m_file) {
+            static_cast<void>(std::setvbuf(m_file, m_fileBuffer.get(),
+                                           _IOFBF, k_fileBufferSize));
+        }
+        m_currentSize = 0U;
+    }
+
+    /** Base file name followed by the rotated names */
+    std::vector<std::string> m_names;
+
+    /** Rotation threshold in bytes, 0 disables rotation */
+    const std::size_t m_maxSize;
+
+    /** Bytes written to the current file */
+    std::size_t m_currentSize;
+
+    /** Open stream, null if reopening after rotation failed */
+    std::FILE* m_file;
+
+    /** stdio buffer, kept across reopen */
+    const std::unique_ptr<char[]> m_fileBuffer;
+};
+
+/**
+ * @brief Sink copying formatted records into a crash ring
+ *
+ * @details
+ * Writing is a copy into shared memory; flushing has nothing to do since
+ * the kernel writes the mapped pages back on its own, also after a crash.
+ */
+class CrashRingSink final : public BufferedSink {
+   public:
+    /**
+     * @brief Map the ring file
+     *
+     * @param[in] path Ring file path
+     * @param[in] capacity Ring data size in bytes
+     * @return Operation result code
+     */
+    E_Result Open(const std::string& path, std::uint64_t capacity) {
+        return m_ring.Open(path, capacity);
+    }
+
+   protected:
+    void WriteFormatted(const spdlog::details::log_msg& msg,
+                        const spdlog::memory_buf_t& text) override {
+        static_cast<void>(msg);
+        m_ring.Write(text.data(), text.size());
+    }
+
+    void flush_() override {}
+
+   private:
+    /** Mapped ring file */
+    crash::CrashRing m_ring;
+};
+
+/**
+ * @brief Frontend sink forwarding records to an asynchronous backend
+ */
+class AsyncForwardSink : public spdlog::sinks::sink {
+   public:
+    explicit AsyncForwardSink(std::shared_ptr<async::AsyncBackend> backend)
+        : m_backend(std::move(backend)) {}
+
+    void log(const spdlog::details::log_msg& msg) override {
+        static_cast<void>(m_backend->Enqueue(msg));
+    }
+
+    void flush() override { static_cast<void>(m_backend->Flush()); }
+
+    void set_pattern(const std::string& pattern) override {
+        m_backend->SetFormatter(spdlog::pattern_formatter(pattern));
+    }
+
+    void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override {
+        if (formatter) {
+            m_backend->SetFormatter(*formatter);
+        }
+    }
+
+   private:
+    /** Backend owning the destination sinks */
+    std::shared_ptr<async::AsyncBackend> m_backend;
+};
+
+/**
+ * @brief Frontend sink collapsing repeated records within a time window
+ *
+ * @details
+ * Records are hashed over call site, level and rendered message into a
+ * fixed direct-mapped table. The call site is hashed by file name text and
+ * line, so the table layout does not depend on where the binary is loaded.
+ * A record matching its slot within the window is counted instead of
+ * forwarded. When the window of a counted slot ends, or another record
+ * takes the slot, one "\"<message>\" repeated N times" record is forwarded
+ * in its place, the message cut to its first k_quoteLength characters.
+ * There is no timer: ended windows are reported by the next record
+ * arriving after the earliest pending deadline, which sweeps the table
+ * once, and by flush.
+ */
+class DedupSink : public spdlog::sinks::sink {
+   public:
+    DedupSink(std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks,
+              std::uint32_t windowMs)
+        : m_sinks(std::move(sinks)),
+          m_window(std::chrono::milliseconds(windowMs)),
+          m_slots{},
+          m_deadline(spdlog::log_clock::time_point::max()) {}
+
+    ~DedupSink(void) override {
+        try {
+            flush();
+        } catch (...) {
+            /* Pending repeat counts are lost */
+        }
+    }
+
+    /* Disable copy and assignment */
+    DedupSink(const DedupSink&) = delete;
+    DedupSink& operator=(const DedupSink&) = delete;
+
+    void log(const spdlog::details::log_msg& msg) override {
+        const std::uint64_t hash = Hash(msg);
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (msg.time >= m_deadline) {
+            Sweep(msg.time);
+        }
+
+        Slot_t& slot = m_slots[hash & (k_slotCount - 1U)];
+        if (slot.m_used && (slot.m_hash == hash) &&
+            ((msg.time - slot.m_start) < m_window)) {
+            if (0U == slot.m_repeats++) {
+                m_deadline = std::min(m_deadline, slot.m_start + m_window);
+            }
+            slot.m_last = msg.time;
+            return;
+        }
+
+        if (slot.m_used) {
+            Report(slot);
+        }
+        slot.m_used = true;
+        slot.m_hash = hash;
+        slot.m_repeats = 0U;
+        slot.m_start = msg.time;
+        slot.m_last = msg.time;
+        slot.m_source = msg.source;
+        slot.m_loggerName = msg.logger_name;
+        slot.m_level = msg.level;
+        slot.m_threadId = msg.thread_id;
+        slot.m_quoteLength = std::min(msg.payload.size(), k_quoteLength);
+        std::memcpy(slot.m_quote, msg.payload.data(), slot.m_quoteLength);
+        slot.m_quoteCut = (msg.payload.size() > k_quoteLength);
+        Forward(msg);
+    }
+
+    void flush() override {
+        {
+            /* Report every pending repeat count before flushing */
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (Slot_t& slot : m_slots) {
+                if (slot.m_used) {
+                    Report(slot);
+                    slot.m_used = false;
+                }
+            }
+            m_deadline = spdlog::log_clock::time_point::max();
+        }
+        for (const auto& destination : m_sinks) {
+            destination->flush();
+        }
+    }
+
+    void set_pattern(const std::string& pattern) override {
+        for (const auto& destination : m_sinks) {
+            destination->set_pattern(pattern);
+        }
+    }
+
+    void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override {
+        if (!formatter) {
+            return;
+        }
+        for (const auto& destination : m_sinks) {
+            destination->set_formatter(formatter->clone());
+        }
+    }
+
+   private:
+    /** Table size, a power of two */
+    static constexpr std::size_t k_slotCount = 256U;
+
+    /** Longest message text quoted in a repeat report */
+    static constexpr std::size_t k_quoteLength = 96U;
+
+    /**
+     * @brief Most recent distinct record of one hash bucket
+     */
+    struct Slot_t {
+        bool m_used;                             /**< Slot holds a record */
+        std::uint64_t m_hash;                    /**< Record hash */
+        std::uint64_t m_repeats;                 /**< Collapsed repeats */
+        spdlog::log_clock::time_point m_start;   /**< Window start */
+        spdlog::log_clock::time_point m_last;    /**< Last repeat */
+        spdlog::source_loc m_source;             /**< Call site */
+        spdlog::string_view_t m_loggerName;      /**< Owning logger */
+        spdlog::level::level_enum m_level;       /**< Severity */
+        std::size_t m_threadId;                  /**< Last thread */
+        char m_quote[k_quoteLength];             /**< Message start */
+        std::size_t m_quoteLength;               /**< Characters in m_quote */
+        bool m_quoteCut;                         /**< Message was longer */
+    };
+
+    /* FNV-1a over call site, level and message */
+    static std::uint64_t Hash(const spdlog::details::log_msg& msg) {
+        std::uint64_t hash = 14695981039346656037ULL;
+        const auto mix = [&hash](const void* data, std::size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0U; i < size; ++i) {
+                hash = (hash ^ bytes[i]) * 1099511628211ULL;
+            }
+        };
+
+        if (nullptr != msg.source.filename) {
+            mix(msg.source.filename, std::strlen(msg.source.filename));
+        }
+        mix(&msg.source.line, sizeof(msg.source.line));
+        mix(&msg.level, sizeof(msg.level));
+        mix(msg.payload.data(), msg.payload.size());
+        return hash;
+    }
+
+    /* Forward a record to the destination sinks */
+    void Forward(const spdlog::details::log_msg& msg) {
+        for (const auto& destination : m_sinks) {
+            if (destination->should_log(msg.level)) {
+                destination->log(msg);
+            }
+        }
+    }
+
+    /* Forward the repeat count of a slot and start counting again */
+    void Report(Slot_t& slot) {
+        if (0U == slot.m_repeats) {
+            return;
+        }
+
+        const std::size_t size = static_cast<std::size_t>(
+            fmt::format_to_n(
+                m_report, sizeof(m_report), "\"{}{}\" repeated {} times",
+                spdlog::string_view_t(slot.m_quote, slot.m_quoteLength),
+                slot.m_quoteCut ? "..." : "", slot.m_repeats)
+                .size);
+        spdlog::details::log_msg report(
+            slot.m_last, slot.m_source, slot.m_loggerName, slot.m_level,
+            spdlog::string_view_t(m_report, std::min(size, sizeof(m_report))));
+        report.thread_id = slot.m_threadId;
+        slot.m_repeats = 0U;
+        Forward(report);
+    }
+
+    /* Report and release slots whose window ended, find the next deadline */
+    void Sweep(spdlog::log_clock::time_point now) {
+        m_deadline = spdlog::log_clock::time_point::max();
+        for (Slot_t& slot : m_slots) {
+            if (!slot.m_used) {
+                continue;
+            }
+            if ((now - slot.m_start) >= m_window) {
+                Report(slot);
+                slot.m_used = false;
+            } else if (slot.m_repeats > 0U) {
+                m_deadline = std::min(m_deadline, slot.m_start + m_window);
+            }
+        }
+    }
+
+    /** Destination sinks */
+    const std::vector<std::shared_ptr<spdlog::sinks::sink>> m_sinks;
+
+    /** Collapsing window */
+    const spdlog::log_clock::duration m_window;
+
+    /** Guards the table and the report buffer */
+    std::mutex m_mutex;
+
+    /** Hash table of recent records */
+    Slot_t m_slots[k_slotCount];
+
+    /** Earliest window end of a slot with repeats */
+    spdlog::log_clock::time_point m_deadline;
+
+    /** Text of the repeat report */
+    char m_report[k_quoteLength + 64U];
+};
+
+/**
+ * @brief Frontend sink formatting each record once per distinct formatter
+ *
+ * @details
+ * Buffered destinations sharing a formatter form a group. A record is
+ * formatted once per group that has a destination accepting its level,
+ * and the same text is written to every destination of the group. Other
+ * destinations, such as syslog, format the record themselves. Setting a
+ * pattern or formatter puts all buffered destinations in one group;
+ * SetOutputFormatter() moves one destination to the group of its key.
+ */
+class FanoutSink : public spdlog::sinks::sink {
+   public:
+    explicit FanoutSink(std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks)
+        : m_sinks(std::move(sinks)) {
+        std::unique_ptr<Group_t> group(new Group_t());
+        group->m_formatter.reset(new spdlog::pattern_formatter());
+        group->m_buffer.reserve(k_sinkBufferReserve);
+
+        for (const auto& destination : m_sinks) {
+            BufferedSink* const buffered =
+                dynamic_cast<BufferedSink*>(destination.get());
+            if (nullptr != buffered) {
+                group->m_sinks.push_back(buffered);
+            } else {
+                m_passThrough.push_back(destination.get());
+            }
+        }
+        if (!group->m_sinks.empty()) {
+            m_groups.push_back(std::move(group));
+        }
+    }
+
+    /* Disable copy and assignment */
+    FanoutSink(const FanoutSink&) = delete;
+    FanoutSink& operator=(const FanoutSink&) = delete;
+
+    void log(const spdlog::details::log_msg& msg) override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& group : m_groups) {
+                WriteGroup(*group, msg);
+            }
+        }
+        for (spdlog::sinks::sink* const destination : m_passThrough) {
+            if (destination->should_log(msg.level)) {
+                destination->log(msg);
+            }
+        }
+    }
+
+    void flush() override {
+        for (const auto& destination : m_sinks) {
+            destination->flush();
+        }
+    }
+
+    void set_pattern(const std::string& pattern) override {
+        set_formatter(std::unique_ptr<spdlog::formatter>(
+            new spdlog::pattern_formatter(pattern)));
+    }
+
+    void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override {
+        if (!formatter) {
+            return;
+        }
+
+        /* Destinations keep a copy for records logged to them directly */
+        for (const auto& destination : m_sinks) {
+            destination->set_formatter(formatter->clone());
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_groups.empty()) {
+            return;
+        }
+        for (std::size_t i = 1U; i < m_groups.size(); ++i) {
+            m_groups[0]->m_sinks.insert(m_groups[0]->m_sinks.end(),
+                                        m_groups[i]->m_sinks.begin(),
+                                        m_groups[i]->m_sinks.end());
+        }
+        m_groups.resize(1U);
+        m_groups[0]->m_formatter = std::move(formatter);
+        m_groups[0]->m_key.clear();
+    }
+
+    /**
+     * @brief Install a formatter on one destination
+     *
+     * @param[in] destination Destination sink of this fan-out
+     * @param[in] formatter Formatter of the destination
+     * @param[in] key Format identity, destinations with equal keys share
+     *            one formatting pass
+     * @return Operation result code
+     */
+    E_Result SetOutputFormatter(spdlog::sinks::sink* destination,
+                                std::unique_ptr<spdlog::formatter> formatter,
+                                const std::string& key) {
+        if (m_sinks.end() ==
+            std::find_if(m_sinks.begin(), m_sinks.end(),
+                         [destination](const auto& owned) {
+                             return owned.get() == destination;
+                         })) {
+            return E_Result::E_INVALID_PARAMETER;
+        }
+
+        BufferedSink* const buffered = dynamic_cast<BufferedSink*>(destination);
+        if (nullptr == buffered) {
+            destination->set_formatter(std::move(formatter));
+            return E_Result::E_SUCCESS;
+        }
+        destination->set_formatter(formatter->clone());
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        /* Leave the current group, dropping it once empty */
+        for (auto it = m_groups.begin(); it != m_groups.end(); ++it) {
+            std::vector<BufferedSink*>& members = (*it)->m_sinks;
+            const auto member = std::find(members.begin(), members.end(),
+                                          buffered);
+            if (members.end() != member) {
+                members.erase(member);
+                if (members.empty()) {
+                    m_groups.erase(it);
+                }
+                break;
+            }
+        }
+
+        for (const auto& group : m_groups) {
+            if (group->m_key == key) {
+                group->m_sinks.push_back(buffered);
+                return E_Result::E_SUCCESS;
+            }
+        }
+
+        std::unique_ptr<Group_t> group(new Group_t());
+        group->m_formatter = std::move(formatter);
+        group->m_key = key;
+        group->m_sinks.push_back(buffered);
+        group->m_buffer.reserve(k_sinkBufferReserve);
+        m_groups.push_back(std::move(group));
+        return E_Result::E_SUCCESS;
+    }
+
+   private:
+    /**
+     * @brief Buffered destinations sharing one formatter
+     */
+    struct Group_t {
+        std::unique_ptr<spdlog::formatter> m_formatter; /**< Shared format */
+        std::string m_key;                  /**< Format identity, or empty */
+        std::vector<BufferedSink*> m_sinks; /**< Destinations */
+        spdlog::memory_buf_t m_buffer;      /**< Formatted text */
+    };
+
+    /* Format a record once and write it to the group, m_mutex held */
+    static void WriteGroup(Group_t& group,
+                           const spdlog::details::log_msg& msg) {
+        bool formatted = false;
+        for (BufferedSink* const destination : group.m_sinks) {
+            if (!destination->should_log(msg.level)) {
+                continue;
+            }
+            if (!formatted) {
+                group.m_buffer.clear();
+                group.m_formatter->format(msg, group.m_buffer);
+                formatted = true;
+            }
+            destination->WriteText(msg, group.m_buffer);
+        }
+    }
+
+    /** Destination sinks, owned */
+    const std::vector<std::shared_ptr<spdlog::sinks::sink>> m_sinks;
+
+    /** Groups of buffered destinations, guarded by m_mutex */
+    std::vector<std::unique_ptr<Group_t>> m_groups;
+
+    /** Destinations formatting records themselves */
+    std::vector<spdlog::sinks::sink*> m_passThrough;
+
+    /** Guards the groups, their formatters and buffers */
+    std::mutex m_mutex;
+};
+
 std::shared_ptr<spdlog::sinks::sink> CreateConsoleSink(bool colored) {
     /* Thread synchronization for allocation tracking */
     std::lock_guard<std::mutex> lock(g_sinkMutex);
@@ -49,11 +762,7 @@ std::shared_ptr<spdlog::sinks::sink> CreateConsoleSink(bool colored) {
     try {
         std::shared_ptr<spdlog::sinks::sink> result;
 
-        if (colored) {
-            result = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-        } else {
-            result = std::make_shared<spdlog::sinks::stdout_sink_mt>();
-        }
+        result = std::make_shared<ConsoleSink>(colored);
 
         if (result) {
             ++g_sinkAllocationCount;
@@ -114,13 +823,8 @@ std::shared_ptr<spdlog::sinks::sink> CreateFileSink(const std::string& filename,
             maxFiles = k_maxFileCountLimit;
         }
 
-        if (rotate) {
-            result = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
-                filename, maxSize, maxFiles);
-        } else {
-            result =
-                std::make_shared<spdlog::sinks::basic_file_sink_mt>(filename);
-        }
+        result = std::make_shared<FileSink>(filename, rotate ? maxSize : 0U,
+                                            maxFiles);
 
         if (result) {
             ++g_sinkAllocationCount;
@@ -192,6 +896,140 @@ std::shared_ptr<spdlog::sinks::sink> CreateNullSink(void) {
     }
 }
 
+std::shared_ptr<spdlog::sinks::sink> CreateCrashRingSink(
+    const std::string& path, std::uint64_t capacity) {
+    /* Thread synchronization for allocation tracking */
+    std::lock_guard<std::mutex> lock(g_sinkMutex);
+
+    /* Check allocation limit */
+    if (g_sinkAllocationCount >= k_maxSinkAllocations) {
+        return nullptr;
+    }
+
+    try {
+        auto result = std::make_shared<CrashRingSink>();
+        if (E_Result::E_SUCCESS != result->Open(path, capacity)) {
+            return nullptr;
+        }
+
+        ++g_sinkAllocationCount;
+        return result;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+std::shared_ptr<spdlog::sinks::sink> CreateAsyncSink(
+    std::shared_ptr<async::AsyncBackend> backend) {
+    /* Parameter validation */
+    if (!backend) {
+        return nullptr;
+    }
+
+    /* Thread synchronization for allocation tracking */
+    std::lock_guard<std::mutex> lock(g_sinkMutex);
+
+    /* Check allocation limit */
+    if (g_sinkAllocationCount >= k_maxSinkAllocations) {
+        return nullptr;
+    }
+
+    try {
+        std::shared_ptr<spdlog::sinks::sink> result =
+            std::make_shared<AsyncForwardSink>(std::move(backend));
+
+        if (result) {
+            ++g_sinkAllocationCount;
+        }
+
+        return result;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+std::shared_ptr<spdlog::sinks::sink> CreateDedupSink(
+    std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks,
+    std::uint32_t windowMs) {
+    /* Parameter validation */
+    if (sinks.empty() || (0U == windowMs)) {
+        return nullptr;
+    }
+
+    /* Thread synchronization for allocation tracking */
+    std::lock_guard<std::mutex> lock(g_sinkMutex);
+
+    /* Check allocation limit */
+    if (g_sinkAllocationCount >= k_maxSinkAllocations) {
+        return nullptr;
+    }
+
+    try {
+        std::shared_ptr<spdlog::sinks::sink> result =
+            std::make_shared<DedupSink>(std::move(sinks), windowMs);
+
+        if (result) {
+            ++g_sinkAllocationCount;
+        }
+
+        return result;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+std::shared_ptr<spdlog::sinks::sink> CreateFanoutSink(
+    std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks) {
+    /* Parameter validation */
+    if (sinks.empty()) {
+        return nullptr;
+    }
+
+    /* Thread synchronization for allocation tracking */
+    std::lock_guard<std::mutex> lock(g_sinkMutex);
+
+    /* Check allocation limit */
+    if (g_sinkAllocationCount >= k_maxSinkAllocations) {
+        return nullptr;
+    }
+
+    try {
+        std::shared_ptr<spdlog::sinks::sink> result =
+            std::make_shared<FanoutSink>(std::move(sinks));
+
+        if (result) {
+            ++g_sinkAllocationCount;
+        }
+
+        return result;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+E_Result SetOutputFormatter(
+    const std::shared_ptr<spdlog::sinks::sink>& fanout,
+    const std::shared_ptr<spdlog::sinks::sink>& output,
+    std::unique_ptr<spdlog::formatter> formatter, const std::string& key) {
+    /* Parameter validation */
+    if (!output || !formatter) {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    try {
+        FanoutSink* const fanoutSink = dynamic_cast<FanoutSink*>(fanout.get());
+        if (nullptr == fanoutSink) {
+            output->set_formatter(std::move(formatter));
+            return E_Result::E_SUCCESS;
+        }
+
+        return fanoutSink->SetOutputFormatter(output.get(),
+                                              std::move(formatter), key);
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
 std::vector<std::shared_ptr<spdlog::sinks::sink>> CreateMultiSink(
     bool console, const std::string& logFile, bool syslog) {
     std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks;
@@ -239,6 +1077,22 @@ std::uint32_t GetSinkAllocationCount(void) {
     return g_sinkAllocationCount.load(std::memory_order_relaxed);
 }
 
+std::vector<std::shared_ptr<spdlog::sinks::sink>> CreateMultiSink(
+    bool console, const std::string& logFile, bool syslog,
+    std::uint32_t dedupWindowMs) {
+    std::vector<std::shared_ptr<spdlog::sinks::sink>> sinks =
+        CreateMultiSink(console, logFile, syslog);
+
+    if ((dedupWindowMs > 0U) && !sinks.empty()) {
+        auto dedupSink = CreateDedupSink(sinks, dedupWindowMs);
+        if (dedupSink) {
+            sinks.assign(1U, dedupSink);
+        }
+    }
+
+    return sinks;
+}
+
 } /* namespace sinks */
 } /* namespace logger */
-} /* namespace vsn */
\ No newline at end of file
+} /* namespace vsn */
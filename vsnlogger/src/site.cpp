@@ -0,0 +1,62 @@
+/**
+ * @file site.cpp
+ * @brief Implementation of the call-site registry for VSNLogger
+ *
+ * @details
+ * Registered sites form an intrusive singly linked list threaded through
+ * the static descriptors themselves, so registration never allocates.
+ * Insertion is serialized; readers walk the published list without a lock
+ * because a site's link is written before the site becomes the list head
+ * and never changes afterwards.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include "vsnlogger/site.h"
+
+#include <mutex>
+
+namespace vsn {
+namespace logger {
+
+/* Serializes insertion into the registry */
+static std::mutex g_siteMutex;
+
+/* Most recently registered site */
+static std::atomic<const LogSite_t*> g_siteHead(nullptr);
+
+void RegisterLogSite(LogSite_t& site) {
+    try {
+        std::lock_guard<std::mutex> lock(g_siteMutex);
+
+        if (site.m_registered.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        site.m_next = g_siteHead.load(std::memory_order_relaxed);
+        g_siteHead.store(&site, std::memory_order_release);
+        site.m_registered.store(true, std::memory_order_release);
+    } catch (...) {
+        /* Registration is retried on the next call through the site */
+    }
+}
+
+E_Result EnumerateLogSites(LogSiteVisitor_t visitor, void* context) {
+    if (nullptr == visitor) {
+        return E_Result::E_INVALID_PARAMETER;
+    }
+
+    try {
+        for (const LogSite_t* site = g_siteHead.load(std::memory_order_acquire);
+             nullptr != site; site = site->m_next) {
+            visitor(*site, context);
+        }
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+} /* namespace logger */
+} /* namespace vsn */
@@ -0,0 +1,320 @@
+/**
+ * @file timer.cpp
+ * @brief Implementation of scoped latency timers for VSNLogger
+ *
+ * @details
+ * Every thread owns one shard with a histogram per site it timed, allocated
+ * on the first duration recorded for that site. Only the owning thread
+ * writes a shard, with relaxed load-store pairs instead of locked
+ * read-modify-write operations; the reporter reads the counters while they
+ * change. Counters only grow, so a report subtracts the totals it saw last
+ * time. A thread folds its shard into per-site retired totals on exit.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include "vsnlogger/timer.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vsn {
+namespace logger {
+
+/**
+ * @brief Histogram of one site written by one thread
+ */
+struct TimerHistogram_t {
+    std::atomic<std::uint64_t> m_counts[k_timerBucketCount];
+    std::atomic<std::uint64_t> m_max; /**< Longest duration since reported */
+};
+
+/**
+ * @brief Totals of one site kept by the reporter
+ */
+struct TimerTotals_t {
+    std::uint64_t m_reported[k_timerBucketCount]; /**< Counts last reported */
+    std::uint64_t m_retired[k_timerBucketCount];  /**< Exited threads */
+    std::uint64_t m_retiredMax; /**< Longest duration of exited threads */
+};
+
+/**
+ * @brief Histograms of the calling thread, folded into the totals on exit
+ */
+struct TimerShard_t {
+    TimerShard_t(void) : m_registered(false) {}
+    ~TimerShard_t(void);
+
+    std::unique_ptr<TimerHistogram_t> m_sites[k_maxTimerSites];
+    bool m_registered; /**< Listed in g_timerShards */
+};
+
+/**
+ * @brief Interval summary of one site
+ */
+struct TimerSummary_t {
+    const TimerSite_t* m_site;
+    std::uint64_t m_count;
+    std::uint64_t m_p50;
+    std::uint64_t m_p99;
+    std::uint64_t m_p999;
+    std::uint64_t m_max;
+};
+
+/* Serializes registration, reports and shard retirement */
+static std::mutex g_timerMutex;
+
+/* Registered sites and their totals, guarded by g_timerMutex */
+static TimerSite_t* g_timerSites[k_maxTimerSites];
+static std::unique_ptr<TimerTotals_t> g_timerTotals[k_maxTimerSites];
+static std::uint32_t g_timerSiteCount = 0U;
+
+/* Shards of live threads, guarded by g_timerMutex */
+static std::vector<TimerShard_t*> g_timerShards;
+
+/* Interval between automatic reports in ns, 0 disables them */
+static std::atomic<std::uint64_t> g_timerInterval(
+    static_cast<std::uint64_t>(k_defaultTimerReportMs) * 1000000U);
+
+/* Time of the next automatic report */
+static std::atomic<std::uint64_t> g_timerDeadline(0U);
+
+/* Shard of the calling thread */
+static thread_local TimerShard_t t_timerShard;
+
+TimerShard_t::~TimerShard_t(void) {
+    if (!m_registered) {
+        return;
+    }
+
+    try {
+        std::lock_guard<std::mutex> lock(g_timerMutex);
+
+        for (std::uint32_t i = 0U; i < g_timerSiteCount; ++i) {
+            const TimerHistogram_t* const histogram = m_sites[i].get();
+            if (nullptr == histogram) {
+                continue;
+            }
+            TimerTotals_t& totals = *g_timerTotals[i];
+            for (std::uint32_t b = 0U; b < k_timerBucketCount; ++b) {
+                totals.m_retired[b] +=
+                    histogram->m_counts[b].load(std::memory_order_relaxed);
+            }
+            totals.m_retiredMax =
+                std::max(totals.m_retiredMax,
+                         histogram->m_max.load(std::memory_order_relaxed));
+        }
+
+        g_timerShards.erase(
+            std::remove(g_timerShards.begin(), g_timerShards.end(), this),
+            g_timerShards.end());
+    } catch (...) {
+        /* Counts of this thread are lost */
+    }
+}
+
+/* Assign a registry index to a site */
+static std::uint32_t RegisterTimerSite(TimerSite_t& site) {
+    try {
+        std::lock_guard<std::mutex> lock(g_timerMutex);
+
+        std::uint32_t id = site.m_id.load(std::memory_order_relaxed);
+        if (k_unregisteredTimer != id) {
+            return id;
+        }
+
+        id = k_droppedTimer;
+        if (g_timerSiteCount < k_maxTimerSites) {
+            g_timerTotals[g_timerSiteCount].reset(new TimerTotals_t());
+            g_timerSites[g_timerSiteCount] = &site;
+            id = g_timerSiteCount++;
+        }
+
+        site.m_id.store(id, std::memory_order_release);
+        return id;
+    } catch (...) {
+        return k_droppedTimer;
+    }
+}
+
+/* Allocate the calling thread's histogram of a site */
+static TimerHistogram_t* AcquireHistogram(std::uint32_t id) {
+    try {
+        std::unique_ptr<TimerHistogram_t> histogram(new TimerHistogram_t());
+
+        std::lock_guard<std::mutex> lock(g_timerMutex);
+        if (!t_timerShard.m_registered) {
+            g_timerShards.push_back(&t_timerShard);
+            t_timerShard.m_registered = true;
+        }
+        t_timerShard.m_sites[id] = std::move(histogram);
+        return t_timerShard.m_sites[id].get();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void RecordTimer(TimerSite_t& site, std::uint64_t start, std::uint64_t end) {
+    std::uint32_t id = site.m_id.load(std::memory_order_acquire);
+    if (k_unregisteredTimer == id) {
+        id = RegisterTimerSite(site);
+    }
+    if (id >= k_maxTimerSites) {
+        return;
+    }
+
+    TimerHistogram_t* histogram = t_timerShard.m_sites[id].get();
+    if (nullptr == histogram) {
+        histogram = AcquireHistogram(id);
+        if (nullptr == histogram) {
+            return;
+        }
+    }
+
+    /* Single writer: plain increments, readers tolerate stale values */
+    const std::uint64_t ns = end - start;
+    std::atomic<std::uint64_t>& count =
+        histogram->m_counts[detail::TimerBucket(ns)];
+    count.store(count.load(std::memory_order_relaxed) + 1U,
+                std::memory_order_relaxed);
+    if (ns > histogram->m_max.load(std::memory_order_relaxed)) {
+        histogram->m_max.store(ns, std::memory_order_relaxed);
+    }
+
+    /* The thread that moves the deadline reports */
+    const std::uint64_t interval =
+        g_timerInterval.load(std::memory_order_relaxed);
+    if (0U == interval) {
+        return;
+    }
+    std::uint64_t deadline = g_timerDeadline.load(std::memory_order_relaxed);
+    if ((end >= deadline) &&
+        g_timerDeadline.compare_exchange_strong(deadline, end + interval,
+                                                std::memory_order_relaxed)) {
+        /* The first deadline only starts the clock */
+        if (0U != deadline) {
+            static_cast<void>(ReportTimers(*Logger::GetDefaultLogger()));
+        }
+    }
+}
+
+/* Duration of the bucket holding the given rank */
+static std::uint64_t Percentile(const std::uint64_t* counts,
+                                std::uint64_t total, std::uint64_t perMille,
+                                std::uint64_t max) {
+    const std::uint64_t rank = std::max<std::uint64_t>(
+        1U, ((total * perMille) + 999U) / 1000U);
+    std::uint64_t seen = 0U;
+    for (std::uint32_t b = 0U; b < k_timerBucketCount; ++b) {
+        seen += counts[b];
+        if (seen >= rank) {
+            return std::min(detail::TimerBucketValue(b), max);
+        }
+    }
+    return max;
+}
+
+/* Collect the interval summaries, caller holds g_timerMutex */
+static void Summarize(std::vector<TimerSummary_t>& summaries) {
+    std::uint64_t current[k_timerBucketCount];
+    std::uint64_t delta[k_timerBucketCount];
+
+    for (std::uint32_t i = 0U; i < g_timerSiteCount; ++i) {
+        TimerTotals_t& totals = *g_timerTotals[i];
+
+        std::copy(totals.m_retired, totals.m_retired + k_timerBucketCount,
+                  current);
+        std::uint64_t max = totals.m_retiredMax;
+        totals.m_retiredMax = 0U;
+        for (TimerShard_t* const shard : g_timerShards) {
+            TimerHistogram_t* const histogram = shard->m_sites[i].get();
+            if (nullptr == histogram) {
+                continue;
+            }
+            for (std::uint32_t b = 0U; b < k_timerBucketCount; ++b) {
+                current[b] +=
+                    histogram->m_counts[b].load(std::memory_order_relaxed);
+            }
+            max = std::max(
+                max, histogram->m_max.exchange(0U, std::memory_order_relaxed));
+        }
+
+        std::uint64_t total = 0U;
+        for (std::uint32_t b = 0U; b < k_timerBucketCount; ++b) {
+            delta[b] = current[b] - totals.m_reported[b];
+            totals.m_reported[b] = current[b];
+            total += delta[b];
+        }
+        if (0U == total) {
+            continue;
+        }
+
+        summaries.push_back(TimerSummary_t{
+            g_timerSites[i], total, Percentile(delta, total, 500U, max),
+            Percentile(delta, total, 990U, max),
+            Percentile(delta, total, 999U, max), max});
+    }
+}
+
+/* Render a duration with a unit suited to its magnitude */
+static void FormatDuration(std::uint64_t ns, char (&text)[24]) {
+    if (ns < 1000U) {
+        std::snprintf(text, sizeof(text), "%" PRIu64 "ns", ns);
+    } else if (ns < 1000000U) {
+        std::snprintf(text, sizeof(text), "%.1fus",
+                      static_cast<double>(ns) / 1e3);
+    } else if (ns < 1000000000U) {
+        std::snprintf(text, sizeof(text), "%.1fms",
+                      static_cast<double>(ns) / 1e6);
+    } else {
+        std::snprintf(text, sizeof(text), "%.2fs",
+                      static_cast<double>(ns) / 1e9);
+    }
+}
+
+E_Result ReportTimers(Logger& logger) {
+    try {
+        std::vector<TimerSummary_t> summaries;
+        {
+            std::lock_guard<std::mutex> lock(g_timerMutex);
+            Summarize(summaries);
+        }
+
+        /* Log outside the lock, sinks may be slow */
+        for (const TimerSummary_t& summary : summaries) {
+            char p50[24];
+            char p99[24];
+            char p999[24];
+            char max[24];
+            FormatDuration(summary.m_p50, p50);
+            FormatDuration(summary.m_p99, p99);
+            FormatDuration(summary.m_p999, p999);
+            FormatDuration(summary.m_max, max);
+
+            const TimerSite_t& site = *summary.m_site;
+            static_cast<void>(logger.LogWithLocation(
+                SourceLocation_t{site.m_filename, site.m_line, site.m_name},
+                site.m_level, "timer {}: n={} p50={} p99={} p999={} max={}",
+                site.m_name, summary.m_count, p50, p99, p999, max));
+        }
+
+        return E_Result::E_SUCCESS;
+    } catch (...) {
+        return E_Result::E_UNKNOWN_ERROR;
+    }
+}
+
+E_Result SetTimerReportInterval(std::uint32_t intervalMs) {
+    g_timerInterval.store(static_cast<std::uint64_t>(intervalMs) * 1000000U,
+                          std::memory_order_relaxed);
+    g_timerDeadline.store(0U, std::memory_order_relaxed);
+    return E_Result::E_SUCCESS;
+}
+
+} /* namespace logger */
+} /* namespace vsn */
@@ -0,0 +1,234 @@
+/**
+ * @file alloc_test.cpp
+ * @brief Check that steady-state logging does not allocate
+ *
+ * @details
+ * Usage: alloc_test <scratch log file>
+ *
+ * Global operator new is replaced by a counting version. Each sink is
+ * warmed up with a few short records, then a burst of short and long
+ * records must not allocate at all. The same holds for the VSN_* macros
+ * after Logger::Initialize() in synchronous, asynchronous, deferred and
+ * per-thread ring mode, counting the writer threads as well.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "vsnlogger/async.h"
+#include "vsnlogger/config.h"
+#include "vsnlogger/formatters.h"
+#include "vsnlogger/macros.h"
+#include "vsnlogger/sinks.h"
+
+/* Allocations made while counting */
+static std::atomic<std::uint64_t> g_allocations(0U);
+
+/* Set while the measured burst runs */
+static std::atomic<bool> g_counting(false);
+
+/* Set on a thread whose allocations are not part of the measurement */
+static thread_local bool t_uncounted = false;
+
+void* operator new(std::size_t size) {
+    if (g_counting.load(std::memory_order_relaxed) && !t_uncounted) {
+        g_allocations.fetch_add(1U, std::memory_order_relaxed);
+    }
+    void* const memory = std::malloc((size > 0U) ? size : 1U);
+    if (nullptr == memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+using vsn::logger::E_LogLevel;
+using vsn::logger::E_Result;
+using vsn::logger::LogConfig;
+using vsn::logger::Logger;
+namespace async = vsn::logger::async;
+namespace formatters = vsn::logger::formatters;
+namespace sinks = vsn::logger::sinks;
+
+namespace {
+
+/** Records logged before counting starts */
+constexpr int k_warmupRecords = 16;
+
+/** Records of each kind in the measured burst */
+constexpr int k_measuredRecords = 1000;
+
+/**
+ * @brief Log a burst through one sink and count its allocations
+ *
+ * @param[in] name Case name, also the logger name
+ * @param[in] sink Sink under test
+ * @param[in] json Use the JSON formatter instead of a text pattern
+ * @return true if the burst did not allocate
+ */
+bool RunCase(const char* name,
+             const std::shared_ptr<spdlog::sinks::sink>& sink, bool json) {
+    if (!sink) {
+        std::fprintf(stderr, "%s: sink creation failed\n", name);
+        return false;
+    }
+
+    auto backend = std::make_shared<spdlog::logger>(name, sink);
+    if (json) {
+        std::unique_ptr<spdlog::formatter> formatter;
+        if (E_Result::E_SUCCESS !=
+            formatters::CreateJsonFormatter(name, formatter)) {
+            std::fprintf(stderr, "%s: formatter creation failed\n", name);
+            return false;
+        }
+        backend->set_formatter(std::move(formatter));
+    } else {
+        std::string pattern;
+        static_cast<void>(formatters::GetPattern("colored", pattern));
+        backend->set_pattern(pattern);
+    }
+    backend->set_level(spdlog::level::trace);
+
+    Logger logger(backend);
+    static_cast<void>(logger.SetMaxMessageLength(4000U));
+    static_cast<void>(logger.PrepareThread());
+
+    /* Long enough to spill any stack buffer, escaped by JSON */
+    std::string text(3000U, 'x');
+    text[100U] = '"';
+    text[2000U] = '\n';
+
+    /* Short records only: buffers must already fit the longest record */
+    for (int i = 0; i < k_warmupRecords; ++i) {
+        logger.Info(VSN_SRC_LOC, "warm-up {}", i);
+    }
+
+    g_allocations.store(0U, std::memory_order_relaxed);
+    g_counting.store(true, std::memory_order_relaxed);
+    for (int i = 0; i < k_measuredRecords; ++i) {
+        logger.Info(VSN_SRC_LOC, "short {} {}", i, 2.5);
+        logger.Warn(VSN_SRC_LOC, "long {} {}", i, text);
+    }
+    g_counting.store(false, std::memory_order_relaxed);
+
+    const std::uint64_t allocations =
+        g_allocations.load(std::memory_order_relaxed);
+    std::fprintf(stderr, "%-12s %llu allocations in %d records\n", name,
+                 static_cast<unsigned long long>(allocations),
+                 2 * k_measuredRecords);
+    return 0U == allocations;
+}
+
+/**
+ * @brief Log a burst through the macros after Initialize()
+ *
+ * @details
+ * Writer threads are counted too: counting stops only once Flush() has
+ * seen every record written, and Flush() itself is not counted.
+ *
+ * @param[in] name Case name, also the application name
+ * @param[in] logDir Directory receiving the log file
+ * @param[in] options Asynchronous mode settings
+ * @return true if the burst did not allocate
+ */
+bool RunMacroCase(const char* name, const std::string& logDir,
+                  const async::AsyncOptions_t& options) {
+    auto& config = LogConfig::GetInstance();
+    static_cast<void>(config.Set(name, "console_output", "true"));
+    static_cast<void>(config.Set(name, "file_output", "true"));
+    static_cast<void>(config.Set(name, "max_message_length", "4000"));
+    if (E_Result::E_SUCCESS !=
+        Logger::Initialize(name, logDir, E_LogLevel::E_INFO, options)) {
+        std::fprintf(stderr, "%s: initialization failed\n", name);
+        return false;
+    }
+    auto& logger = Logger::GetDefaultLogger();
+    static_cast<void>(logger->PrepareThread());
+
+    std::string text(3000U, 'x');
+    text[100U] = '"';
+    text[2000U] = '\n';
+
+    for (int i = 0; i < k_warmupRecords; ++i) {
+        VSN_INFO("warm-up {}", i);
+    }
+    static_cast<void>(logger->Flush());
+
+    g_allocations.store(0U, std::memory_order_relaxed);
+    g_counting.store(true, std::memory_order_relaxed);
+    for (int i = 0; i < k_measuredRecords; ++i) {
+        VSN_INFO("short {} {}", i, 2.5);
+        VSN_WARN("long {} {}", i, text);
+        /* Deferred: a few argument bytes decoded to a long text */
+        VSN_ERROR("padded {:>3000}", i);
+        VSN_DEBUG("disabled {}", i);
+    }
+    t_uncounted = true;
+    static_cast<void>(logger->Flush());
+    t_uncounted = false;
+    g_counting.store(false, std::memory_order_relaxed);
+
+    static_cast<void>(Logger::Shutdown());
+
+    const std::uint64_t allocations =
+        g_allocations.load(std::memory_order_relaxed);
+    std::fprintf(stderr, "%-12s %llu allocations in %d records\n", name,
+                 static_cast<unsigned long long>(allocations),
+                 3 * k_measuredRecords);
+    return 0U == allocations;
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "Usage: %s <scratch log file>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const std::string path = argv[1];
+
+    /* Console records are not part of the test output */
+    if (nullptr == std::freopen("/dev/null", "w", stdout)) {
+        return EXIT_FAILURE;
+    }
+
+    bool passed = true;
+    passed = RunCase("null", sinks::CreateNullSink(), false) && passed;
+    passed = RunCase("console", sinks::CreateConsoleSink(true), false) &&
+             passed;
+    passed = RunCase("file", sinks::CreateFileSink(path, false, 0U, 0U),
+                     false) &&
+             passed;
+    passed = RunCase("rotating",
+                     sinks::CreateFileSink(path + ".rot", true, 65536U, 2U),
+                     false) &&
+             passed;
+    passed = RunCase("file_json",
+                     sinks::CreateFileSink(path + ".json", false, 0U, 0U),
+                     true) &&
+             passed;
+
+    const std::string logDir = path + ".d";
+    async::AsyncOptions_t options = async::GetDefaultOptions();
+    passed = RunMacroCase("sync", logDir, options) && passed;
+    options.m_enabled = true;
+    passed = RunMacroCase("async", logDir, options) && passed;
+    options.m_deferredFormatting = true;
+    passed = RunMacroCase("deferred", logDir, options) && passed;
+    options.m_perThreadQueues = true;
+    passed = RunMacroCase("per_thread", logDir, options) && passed;
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
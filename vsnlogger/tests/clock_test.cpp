@@ -0,0 +1,122 @@
+/**
+ * @file clock_test.cpp
+ * @brief Check the drift of the calibrated TSC against the system clock
+ *
+ * @details
+ * Selects the TSC source and samples it against the system clock over
+ * several calibration intervals. Every sample must stay within a few
+ * microseconds of the system clock, plus a drift allowance growing with
+ * the time since the source was selected. A sample out of bounds is
+ * retaken before it counts, so one preemption or clock slew does not fail
+ * the run. Exits with 77, reported as skipped, where the processor has no
+ * invariant counter.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "vsnlogger/clock.h"
+
+using vsn::logger::E_ClockSource;
+using vsn::logger::E_Result;
+using vsn::logger::k_clockCalibrationMs;
+namespace detail = vsn::logger::detail;
+
+namespace {
+
+/** Exit code reported by ctest as a skipped test */
+constexpr int k_skipExitCode = 77;
+
+/** Calibration intervals covered by the samples */
+constexpr std::uint32_t k_sampledIntervals = 3U;
+
+/** Samples taken per calibration interval */
+constexpr std::uint32_t k_samplesPerInterval = 8U;
+
+/** Reads per sample, the one with the tightest system clock bracket wins */
+constexpr std::uint32_t k_readsPerSample = 16U;
+
+/** Largest accepted distance from the system clock right after selection */
+constexpr std::int64_t k_maxErrorNs = 5000;
+
+/** Accepted drift per millisecond since selection, 20 ppm */
+constexpr std::int64_t k_driftNsPerMs = 20;
+
+/** Samples retaken before one out of bounds counts */
+constexpr std::uint32_t k_sampleRetries = 3U;
+
+/**
+ * @brief Measure the distance of the TSC from the system clock
+ *
+ * @details
+ * The TSC is read between two system clock reads and compared to their
+ * midpoint, so a read descheduled between them only widens the bracket.
+ *
+ * @return TSC time minus system time in nanoseconds
+ */
+std::int64_t SampleError(void) {
+    std::int64_t best = 0;
+    std::uint64_t bestWidth = UINT64_MAX;
+    for (std::uint32_t i = 0U; i < k_readsPerSample; ++i) {
+        const std::uint64_t before = detail::SystemTicks();
+        const std::uint64_t tsc =
+            detail::ClockTicksToNanos(detail::ClockTicks());
+        const std::uint64_t after = detail::SystemTicks();
+        if ((after - before) < bestWidth) {
+            bestWidth = after - before;
+            best = static_cast<std::int64_t>(tsc - before) -
+                   static_cast<std::int64_t>(bestWidth / 2U);
+        }
+    }
+    return best;
+}
+
+} /* namespace */
+
+int main(void) {
+    if (E_Result::E_SUCCESS !=
+        vsn::logger::SetClockSource(E_ClockSource::E_TSC)) {
+        std::fprintf(stderr, "No invariant TSC, skipped\n");
+        return k_skipExitCode;
+    }
+
+    const auto selected = std::chrono::steady_clock::now();
+    const std::chrono::milliseconds period(k_clockCalibrationMs /
+                                           k_samplesPerInterval);
+    bool passed = true;
+    std::int64_t worst = 0;
+    for (std::uint32_t i = 0U; i < k_sampledIntervals * k_samplesPerInterval;
+         ++i) {
+        std::this_thread::sleep_for(period);
+        const std::int64_t elapsedMs =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - selected)
+                .count();
+        const std::int64_t bound = k_maxErrorNs + (elapsedMs * k_driftNsPerMs);
+        std::int64_t error = SampleError();
+        for (std::uint32_t retry = 0U;
+             (retry < k_sampleRetries) && (std::llabs(error) > bound);
+             ++retry) {
+            error = SampleError();
+        }
+        if (std::llabs(error) > bound) {
+            passed = false;
+        }
+        if (std::llabs(error) > std::llabs(worst)) {
+            worst = error;
+        }
+    }
+
+    static_cast<void>(vsn::logger::SetClockSource(E_ClockSource::E_SYSTEM));
+
+    std::fprintf(stderr, "Largest TSC error over %u ms: %lld ns\n",
+                 k_sampledIntervals * k_clockCalibrationMs,
+                 static_cast<long long>(worst));
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file format_test.cpp
+ * @brief Check bounded formatting at and around the message limit
+ *
+ * @details
+ * Formats arguments whose text ends just below, at and just past the limit
+ * through FormatBounded() with a compiled and with a run-time format, with
+ * and without a component prefix and with multi-byte characters at the
+ * cut. Both paths must produce the text a plain fmt::format() followed by
+ * a reference truncation produces.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "vsnlogger/format.h"
+
+using vsn::logger::k_maxMessageBuffer;
+using vsn::logger::k_truncationMarker;
+namespace detail = vsn::logger::detail;
+
+namespace {
+
+/** Limits tested, the largest one fills the per-thread buffer */
+const std::size_t k_limits[] = {24U, 256U, k_maxMessageBuffer};
+
+/** Component prefix placed ahead of the message */
+const std::string k_prefix = "[component] ";
+
+/**
+ * @brief Cut a message to the limit, written from the documented rules
+ */
+std::string ReferenceBound(const std::string& text, std::size_t limit) {
+    if (text.size() <= limit) {
+        return text;
+    }
+
+    const std::string marker(k_truncationMarker);
+    std::size_t cut = limit - marker.size();
+    while ((cut > 0U) &&
+           (0x80U == (static_cast<unsigned char>(text[cut]) & 0xC0U))) {
+        --cut;
+    }
+    return text.substr(0U, cut) + marker;
+}
+
+/**
+ * @brief Format one argument both ways and compare with the reference
+ *
+ * @return true if both paths match
+ */
+bool CheckArgument(std::size_t limit, bool prefixed, const std::string& arg,
+                   std::uint32_t count) {
+    const char* const prefix = prefixed ? k_prefix.c_str() : nullptr;
+    const std::size_t prefixLength = prefixed ? k_prefix.size() : 0U;
+    const std::string expected = ReferenceBound(
+        (prefixed ? k_prefix : std::string()) +
+            fmt::format("<{}> {}", arg, count),
+        limit);
+
+    const spdlog::string_view_t compiled =
+        detail::FormatBounded(limit, prefix, prefixLength,
+                              FMT_COMPILE("<{}> {}"), "<{}> {}", arg, count);
+    bool passed = (std::string(compiled.data(), compiled.size()) == expected);
+    if (!passed) {
+        std::fprintf(stderr, "Compiled format differs, limit %zu, %zu bytes\n",
+                     limit, arg.size());
+    }
+
+    const spdlog::string_view_t runtime =
+        detail::FormatBounded(limit, prefix, prefixLength,
+                              detail::RuntimeFormat_t(), "<{}> {}", arg, count);
+    if (std::string(runtime.data(), runtime.size()) != expected) {
+        std::fprintf(stderr, "Runtime format differs, limit %zu, %zu bytes\n",
+                     limit, arg.size());
+        passed = false;
+    }
+    return passed;
+}
+
+} /* namespace */
+
+int main(void) {
+    bool passed = true;
+    for (const std::size_t limit : k_limits) {
+        for (const bool prefixed : {false, true}) {
+            /* "<" + arg + "> 7" is arg + 4 bytes */
+            const std::size_t fixed = 4U + (prefixed ? k_prefix.size() : 0U);
+            for (std::size_t length = limit - 16U; length <= limit + 16U;
+                 ++length) {
+                const std::size_t argLength =
+                    (length > fixed) ? (length - fixed) : 0U;
+                passed = CheckArgument(limit, prefixed,
+                                       std::string(argLength, 'x'), 7U) &&
+                         passed;
+
+                /* Two-byte characters put the cut inside a sequence */
+                std::string wide;
+                while (wide.size() < argLength) {
+                    wide += "\xC3\xA9";
+                }
+                passed = CheckArgument(limit, prefixed, wide, 7U) && passed;
+            }
+        }
+    }
+
+    /* Far past the limit, nothing is written beyond the buffer */
+    passed = CheckArgument(k_maxMessageBuffer, true,
+                           std::string(4U * k_maxMessageBuffer, 'y'), 7U) &&
+             passed;
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,169 @@
+/**
+ * @file json_escape_test.cpp
+ * @brief Compare the SIMD JSON escaping kernels with the scalar one
+ *
+ * @details
+ * Feeds random and adversarial inputs of 0 to 200 bytes, straddling the
+ * 16 and 32 byte blocks, to every kernel the build and processor offer,
+ * and to JsonWriter::AppendEscaped(). All must produce the scalar output,
+ * which is itself checked against a plain reference escaper.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "vsnlogger/json.h"
+
+using vsn::logger::JsonWriter;
+namespace detail = vsn::logger::detail;
+
+namespace {
+
+/** Longest input tested */
+constexpr std::size_t k_maxLength = 200U;
+
+/** Random inputs per length and input kind */
+constexpr std::uint32_t k_casesPerLength = 200U;
+
+/** Bytes that need an escape or sit at the edges of the escaped ranges */
+const unsigned char k_adversarialBytes[] = {
+    '"',  '\\', 0x00U, 0x01U, 0x08U, 0x09U, 0x0AU, 0x0CU, 0x0DU,
+    0x1FU, 0x20U, 0x7FU, 0x80U, 0xC3U, 0xFFU, 'a',  '/',  '{'};
+
+/**
+ * @brief Escape one byte at a time, written from the JSON grammar
+ */
+std::string ReferenceEscape(const std::string& text) {
+    static const char k_hex[] = "0123456789abcdef";
+    std::string out;
+    for (const char ch : text) {
+        const unsigned char c = static_cast<unsigned char>(ch);
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            case '\b':
+                out += "\\b";
+                break;
+            case '\f':
+                out += "\\f";
+                break;
+            default:
+                if (c < 0x20U) {
+                    out += "\\u00";
+                    out += k_hex[c >> 4U];
+                    out += k_hex[c & 0x0FU];
+                } else {
+                    out += ch;
+                }
+                break;
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Run one kernel into a buffer of exactly the worst-case size
+ */
+std::string RunKernel(detail::EscapeFn_t kernel, const std::string& text) {
+    std::vector<char> out((text.size() * 6U) + 1U);
+    const char* const end =
+        kernel(text.data(), text.data() + text.size(), out.data());
+    return std::string(out.data(), static_cast<std::size_t>(end - out.data()));
+}
+
+/**
+ * @brief Check all kernels on one input
+ *
+ * @return true if every kernel matches the reference
+ */
+bool CheckInput(const detail::EscapeKernels_t& kernels,
+                const std::string& text) {
+    const std::string expected = ReferenceEscape(text);
+
+    bool passed = (RunKernel(kernels.m_scalar, text) == expected);
+    if ((nullptr != kernels.m_sse2) &&
+        (RunKernel(kernels.m_sse2, text) != expected)) {
+        std::fprintf(stderr, "SSE2 kernel differs, length %zu\n",
+                     text.size());
+        passed = false;
+    }
+    if ((nullptr != kernels.m_avx2) &&
+        (RunKernel(kernels.m_avx2, text) != expected)) {
+        std::fprintf(stderr, "AVX2 kernel differs, length %zu\n",
+                     text.size());
+        passed = false;
+    }
+
+    spdlog::memory_buf_t buffer;
+    buffer.append(std::string("prefix"));
+    JsonWriter::AppendEscaped(text, buffer);
+    if (std::string(buffer.data(), buffer.size()) != ("prefix" + expected)) {
+        std::fprintf(stderr, "AppendEscaped differs, length %zu\n",
+                     text.size());
+        passed = false;
+    }
+    return passed;
+}
+
+} /* namespace */
+
+int main(void) {
+    const detail::EscapeKernels_t kernels = detail::GetEscapeKernels();
+    std::fprintf(stderr, "Kernels: scalar%s%s\n",
+                 (nullptr != kernels.m_sse2) ? ", sse2" : "",
+                 (nullptr != kernels.m_avx2) ? ", avx2" : "");
+
+    std::mt19937 random(12345U);
+    std::uniform_int_distribution<int> anyByte(0, 255);
+    std::uniform_int_distribution<std::size_t> adversarialByte(
+        0U, sizeof(k_adversarialBytes) - 1U);
+
+    bool passed = true;
+    for (std::size_t length = 0U; length <= k_maxLength; ++length) {
+        /* One escape at each position, the rest clean */
+        for (std::size_t hit = 0U; hit < length; ++hit) {
+            std::string text(length, 'x');
+            text[hit] = '"';
+            passed = CheckInput(kernels, text) && passed;
+        }
+
+        /* Every byte escaped */
+        passed = CheckInput(kernels, std::string(length, '\x01')) && passed;
+
+        for (std::uint32_t i = 0U; i < k_casesPerLength; ++i) {
+            std::string text(length, ' ');
+            for (auto& ch : text) {
+                ch = static_cast<char>(anyByte(random));
+            }
+            passed = CheckInput(kernels, text) && passed;
+
+            for (auto& ch : text) {
+                ch = static_cast<char>(
+                    k_adversarialBytes[adversarialByte(random)]);
+            }
+            passed = CheckInput(kernels, text) && passed;
+        }
+    }
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file vsnlogger_recover.cpp
+ * @brief Print the records of a crash ring file
+ *
+ * @details
+ * Usage: vsnlogger_recover <ring file>
+ *
+ * Records go to standard output oldest first, followed by a marker line
+ * if the owning process crashed. A summary of the ring goes to standard
+ * error. After a restart the ring of the crashed run is found next to the
+ * configured file with a .prev suffix.
+ *
+ * @author VSNLogger Contributors
+ * @version 1.0.0
+ */
+
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+#include "vsnlogger/crash.h"
+
+using vsn::logger::E_Result;
+using vsn::logger::crash::CrashRingInfo_t;
+using vsn::logger::crash::E_CrashRingState;
+
+/* Describe how the owning process ended */
+static const char* DescribeState(E_CrashRingState state) {
+    switch (state) {
+        case E_CrashRingState::E_ACTIVE:
+            return "running or terminated without closing";
+        case E_CrashRingState::E_CLOSED:
+            return "closed cleanly";
+        case E_CrashRingState::E_CRASHED:
+            return "crashed";
+        default:
+            return "unknown";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (2 != argc) {
+        std::cerr << "Usage: " << argv[0] << " <ring file>" << std::endl;
+        return 2;
+    }
+
+    std::string text;
+    CrashRingInfo_t info;
+    const E_Result result =
+        vsn::logger::crash::RecoverCrashRing(argv[1], text, info);
+    if (E_Result::E_SUCCESS != result) {
+        std::cerr << argv[1]
+                  << ((E_Result::E_INVALID_PARAMETER == result)
+                          ? ": not a crash ring file"
+                          : ": cannot read file")
+                  << std::endl;
+        return 1;
+    }
+
+    const std::time_t started = static_cast<std::time_t>(info.m_startTime);
+    char startText[32] = "";
+    static_cast<void>(std::strftime(startText, sizeof(startText),
+                                    "%Y-%m-%d %H:%M:%S",
+                                    std::localtime(&started)));
+
+    std::cerr << "process " << info.m_pid << " started " << startText << ", "
+              << DescribeState(info.m_state) << ", " << info.m_written
+              << " bytes written"
+              << (info.m_wrapped ? ", oldest records overwritten" : "")
+              << std::endl;
+
+    std::cout << text;
+    if (E_CrashRingState::E_CRASHED == info.m_state) {
+        std::cout << "*** process " << info.m_pid << " crashed with signal "
+                  << info.m_signal << " (" << strsignal(info.m_signal)
+                  << ") ***" << std::endl;
+    }
+
+    return 0;
+}